@@ -5,17 +5,36 @@ gcc -std=c99 -g -c ismael.c -o libismael.o
 
 
 #include "./src/atoc.c"
+#include "./src/fft.c"
 #include "./src/FDP.c"
+#include "./src/histogram.c"
+#include "./src/moments.c"
+#include "./src/spectrum.c"
+#include "./src/tridiag.c"
+#include "./src/transfer.c"
+#include "./src/kpm.c"
+#include "./src/ode.c"
+#include "./src/ode_dense.c"
+#include "./src/ode_complex.c"
+#include "./src/ode_ensemble.c"
+#include "./src/ode_sweep.c"
 #include "./src/correlated_w_bernoulli.c"
 #include "./src/correlated_w_distance.c"
 #include "./src/correlated_w_fourier.c"
 #include "./src/rand.c"
+#include "./src/MT19937_jump.c"
 #if defined(UINT64_MAX)
 # include "./src/MT19937_64.c"
+# include "./src/ziggurat.c"
+# include "./src/alias.c"
+# include "./src/sobol.c"
+# include "./src/halton.c"
 #endif
 #if defined(UINT32_MAX)
 # include "./src/MT19937_32.c"
 #endif
+#include "./src/dSFMT.c"
+#include "./src/philox.c"
 #include "./src/erro.c"
 
 const __ismael_namespace ismael = {
@@ -23,11 +42,95 @@ const __ismael_namespace ismael = {
 #include "./src/rk8.c"
    .random.mt64 = mt19937_64,
    .random.mt32 = mt19937_32,
+   .random.mt64_init = mt19937_64_init,
+   .random.mt64_next = mt19937_64_next,
+   .random.mt64_fill = mt19937_64_fill,
+   .random.mt32_init = mt19937_32_init,
+   .random.mt32_next = mt19937_32_next,
+   .random.mt64_jump_init = mt19937_64_jump_init,
+   .random.mt64_jump = mt19937_64_jump,
+   .random.mt64_split = mt19937_64_split,
+   .random.mt32_jump_init = mt19937_32_jump_init,
+   .random.mt32_jump = mt19937_32_jump,
+   .random.mt32_split = mt19937_32_split,
+   .random.dsfmt_init = dsfmt_init,
+   .random.dsfmt_next = dsfmt_next,
+   .random.dsfmt_fill = dsfmt_fill,
+   .random.normal = ziggurat_normal,
+   .random.normal_fill = ziggurat_normal_fill,
+   .random.exponential = ziggurat_exponential,
+   .random.exponential_fill = ziggurat_exponential_fill,
+   .random.sobol_init = sobol_init,
+   .random.sobol_seek = sobol_seek,
+   .random.sobol_next = sobol_next,
+   .random.sobol_fill = sobol_fill,
+   .random.sobol_free = sobol_free,
+   .random.halton_init = halton_init,
+   .random.halton_seek = halton_seek,
+   .random.halton_next = halton_next,
+   .random.halton_fill = halton_fill,
+   .random.halton_free = halton_free,
+   .random.philox = philox,
+   .random.philox_fill = philox_fill,
    .random.system = system_rand,
    .random.bernoulli = correlated_w_bernoulli,
+   .random.bernoulli_batch = correlated_w_bernoulli_batch,
    .random.distance = correlated_w_distance,
    .random.fourier = correlated_w_fourier,
    .atoc = atoc,
+   .fft = fft,
+   .fft_plan.init = fft_plan_init,
+   .fft_plan.exec = fft_plan_exec,
+   .fft_plan.free = fft_plan_free,
    .FDP = FDP,
+   .moments.init = moments_init,
+   .moments.add = moments_add,
+   .moments.merge = moments_merge,
+   .moments.variance = moments_variance,
+   .moments.skewness = moments_skewness,
+   .moments.kurtosis = moments_kurtosis,
+   .spectrum.init = spectrum_init,
+   .spectrum.add = spectrum_add,
+   .spectrum.correlation = spectrum_correlation,
+   .spectrum.power = spectrum_power,
+   .spectrum.free = spectrum_free,
+   .histogram.init = histogram_init,
+   .histogram.init_edges = histogram_init_edges,
+   .histogram.add = histogram_add,
+   .histogram.merge = histogram_merge,
+   .histogram.pdf = histogram_pdf,
+   .histogram.free = histogram_free,
+   .alias.init = alias_init,
+   .alias.next = alias_next,
+   .alias.fill = alias_fill,
+   .alias.free = alias_free,
+   .tridiag.count = tridiag_count,
+   .tridiag.eigenvalues = tridiag_eigenvalues,
+   .tridiag.eigenvectors = tridiag_eigenvectors,
+   .tridiag.participation = tridiag_participation,
+   .transfer.init = transfer_init,
+   .transfer.add = transfer_add,
+   .transfer.lyapunov = transfer_lyapunov,
+   .transfer.free = transfer_free,
+   .kpm.lattice = kpm_lattice,
+   .kpm.dos = kpm_dos,
+   .kpm.free = kpm_free,
+   .ode.init = ode_init,
+   .ode.set = ode_set,
+   .ode.set_precision = ode_set_precision,
+   .ode.step = ode_step,
+   .ode.evolve = ode_evolve,
+   .ode.interpolate = ode_interpolate,
+   .ode.evolve_event = ode_evolve_event,
+   .ode.free = ode_free,
+   .ode.init_complex = ode_init_complex,
+   .ode.set_complex = ode_set_complex,
+   .ode.get_complex = ode_get_complex,
+   .ode.hamiltonian = ode_hamiltonian,
+   .ode.ensemble_init = ode_ensemble_init,
+   .ode.ensemble_set = ode_ensemble_set,
+   .ode.ensemble_evolve = ode_ensemble_evolve,
+   .ode.ensemble_free = ode_ensemble_free,
+   .ode.sweep = ode_sweep,
    .error = error
 };
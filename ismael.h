@@ -150,6 +150,22 @@ static double _Complex __CIMAG;
 
 
 
+/* *****************************************************************************
+   OpenMP API
+***************************************************************************** */
+
+/* If compiled with OpenMP (-fopenmp in gcc) some loops run in many threads,
+   else the directives are ignored and the code is serial. */
+#if defined(_OPENMP)
+#include <omp.h>
+#define ISMAEL_OMP(directive) _Pragma(#directive)
+#else
+#define ISMAEL_OMP(directive)
+#endif /* _OPENMP */
+
+
+
+
 /* *****************************************************************************
    Linux kernel API
 ***************************************************************************** */
@@ -225,6 +241,140 @@ static double _Complex __CIMAG;
 #if !defined(UINT64_MAX)
 #define uint64_t void
 #endif
+
+/* State of a Mersenne Twister generator, one object per independent stream */
+typedef struct {
+   uint64_t mt[312];
+   int mti;
+} ismael_mt64_state;
+typedef struct {
+   uint32_t mt[624];
+   int mti;
+} ismael_mt32_state;
+typedef struct {
+   uint64_t p[312]; /* x^(2^k - 31) mod phi(x), phi(x) of degree 19937 */
+   int k, w; /* jump of 2^k steps of the generator with words of w bits */
+} ismael_mt_jump;
+/* Quasi-random sequences, see random.sobol_init and random.halton_init */
+typedef struct {
+   int d;
+   uint64_t n; /* the next point */
+   uint64_t *v, *x, *shift; /* direction numbers v[k*d + j], k < 64 */
+} ismael_sobol;
+typedef struct {
+   int d, *base, *K; /* K digits in the base of each dimension */
+   uint64_t n;
+   int *off, *doff, *perm, *digit; /* perm[off[j] + k*base[j] + digit] */
+   uint64_t *X, *w; /* X = x base^K, weight of the digit doff[j] + k */
+   double *scale;
+} ismael_halton;
+/* Moments of a sample, see moments.add */
+typedef struct {
+   long long n;
+   double mean, M2, M3, M4; /* M_k = sum (x - mean)^k */
+   double min, max;
+} ismael_moments;
+/* Plan of the fft of size N, see fft_plan.init */
+typedef struct {
+   int N, M; /* size, size 2^m of the radix-2 transforms */
+   _Complex double *w; /* twiddles exp(-2 pi i k / M), k < M/2 */
+   _Complex double *c, *b, *a; /* Bluestein: chirp, transform of conj(c), work */
+} ismael_fft_plan;
+/* Correlation and power spectrum of sequences, see spectrum.init */
+typedef struct {
+   int n, L, M, np; /* length, fft size 2^m >= 2n, segments, frequencies */
+   long long count; /* sequences added */
+   double *acf, *psd, *window; /* sums of all the sequences */
+   _Complex double *work, *seg;
+   ismael_fft_plan planL, planM; /* transforms of size L and M */
+} ismael_spectrum;
+/* Histogram accumulated chunk by chunk, see histogram.init */
+typedef struct {
+   int bins;
+   double *edges; /* bins+1 increasing edges */
+   double lo, width; /* width is 0 if the bins are not uniform */
+   long long *count;
+   long long n, under, over; /* all samples, samples out of the edges */
+} ismael_histogram;
+/* Sampler of a density of FDP by the alias method, see alias.init */
+typedef struct {
+   int bins;
+   double *edges, *q; /* bins+1 edges, probability to keep the bin i */
+   int *alias; /* the other bin of i */
+   double *c; /* the position in the bin, 4 coefficients per bin */
+} ismael_alias;
+/* Sparse matrix in CSR, the row i is va[p], ja[p] for ia[i] <= p < ia[i+1] */
+typedef struct {
+   int n, *ia, *ja;
+   double *va;
+} ismael_sparse;
+/* Transfer matrices of a chain for m energies, see transfer.init */
+typedef struct {
+   int m;
+   double *E, *psi0, *psi1, *scale; /* psi_{n-1}, psi_n, log2 of the norm */
+   long long n; /* sites */
+} ismael_transfer;
+typedef struct {
+   uint64_t status[192][2]; /* 191 words of 128 bit and the lung */
+   int idx;
+} ismael_dsfmt_state;
+/* Runge-Kutta integrator of dy/dt = f(t, y), see ode.init */
+#define ISMAEL_RK8 8
+#define ISMAEL_RK14 14
+#define ISMAEL_ODE_DOUBLE 0 /* precision of the steps, see ode.set_precision */
+#define ISMAEL_ODE_COMPENSATED 1
+#define ISMAEL_ODE_LONG_DOUBLE 2
+typedef void (*ismael_ode_rhs)(double,const double*,double*,void*);
+typedef void (*ismael_ode_rhsl)(long double,const long double*,long double*,
+void*);
+typedef double (*ismael_ode_event)(double,const double*,void*);
+typedef struct {
+   int method, order, n, s; /* s stages */
+   ismael_ode_rhs f; /* f(t, y, dydt, params) */
+   void *params;
+   double t, *y; /* the solution */
+   bool adaptive;
+   double h, hlast, hmin, hmax, rtol, atol; /* step control */
+   long nsteps, nrejected, nfev; /* statistics */
+   int *ia, *ja; double *va, *c; /* nonzero coefficients of the tableau */
+   double *k, *f0, *ytmp, *y1, *y2; /* workspace */
+   int precision;
+   double tc, *yc; /* compensation of the sums t + h and y + dy */
+   ismael_ode_rhsl fl; /* f in long double, optional */
+   long double tl, *yl, *wl; /* solution and workspace in long double */
+   bool dense; /* keep the last step for ode.interpolate */
+   int nd, nh, nq; bool md; /* see ode_dense.c */
+   double td, hd, *yd; /* the last step, from td to td + hd */
+   double tp, hp; /* and the step before, if nh > 0 */
+   int nc; /* complex components, y = (Re psi, Im psi), see ode.init_complex */
+   bool conserve; /* keep |y|^2 = norm, the value in ode.set */
+   double norm;
+} ismael_ode;
+/* Real symmetric band matrix, H[i][i+k] = d[k][i] for k <= bands, the
+   element H[i][i+k-n] = d[k][i] (i + k >= n) if periodic */
+typedef struct {
+   int n, bands;
+   double **d;
+   bool periodic;
+} ismael_band_hamiltonian;
+/* Initial condition of the problem i of ode.sweep */
+typedef void (*ismael_ode_setup)(int,double*,ismael_ode*,ismael_mt64_state*,
+void*);
+/* K systems integrated together, see ode.ensemble_init */
+typedef void (*ismael_ode_batch_rhs)(const double*,const double*,double*,int,
+void*);
+typedef struct {
+   int method, order, n, K, s;
+   ismael_ode_batch_rhs f; /* f(t, y, dydt, K, params), t[m] */
+   void *params;
+   double *t, *y; /* t[m] and y[i*K + m] of the member m */
+   bool adaptive, individual; /* individual: each member have its own h */
+   double *h, hmin, hmax, rtol, atol; /* step control */
+   long nsteps, nrejected, nfev; /* statistics */
+   int *ia, *ja; double *va, *c; /* nonzero coefficients of the tableau */
+   double *k, *f0, *ytmp, *y1, *y2, *tk; int *ok; /* workspace */
+} ismael_ode_ensemble;
+
 typedef struct {
    struct {
       const long double a[35][35];
@@ -239,23 +389,130 @@ typedef struct {
    struct {
       double (* const mt64)(uint64_t*);
       double (* const mt32)(uint32_t*);
+      void (* const mt64_init)(ismael_mt64_state*,uint64_t);
+      double (* const mt64_next)(ismael_mt64_state*);
+      void (* const mt64_fill)(ismael_mt64_state*,double*,size_t);
+      void (* const mt32_init)(ismael_mt32_state*,uint32_t);
+      double (* const mt32_next)(ismael_mt32_state*);
+      void (* const mt64_jump_init)(ismael_mt_jump*,int);
+      void (* const mt64_jump)(ismael_mt64_state*,const ismael_mt_jump*);
+      void (* const mt64_split)(ismael_mt64_state*,int,uint64_t,int);
+      void (* const mt32_jump_init)(ismael_mt_jump*,int);
+      void (* const mt32_jump)(ismael_mt32_state*,const ismael_mt_jump*);
+      void (* const mt32_split)(ismael_mt32_state*,int,uint32_t,int);
+      void (* const dsfmt_init)(ismael_dsfmt_state*,uint32_t);
+      double (* const dsfmt_next)(ismael_dsfmt_state*);
+      void (* const dsfmt_fill)(ismael_dsfmt_state*,double*,size_t);
+      double (* const normal)(ismael_mt64_state*);
+      void (* const normal_fill)(ismael_mt64_state*,double*,size_t);
+      double (* const exponential)(ismael_mt64_state*);
+      void (* const exponential_fill)(ismael_mt64_state*,double*,size_t);
+      void (* const sobol_init)(ismael_sobol*,int,ismael_mt64_state*);
+      void (* const sobol_seek)(ismael_sobol*,uint64_t);
+      void (* const sobol_next)(ismael_sobol*,double*);
+      void (* const sobol_fill)(ismael_sobol*,double*,size_t);
+      void (* const sobol_free)(ismael_sobol*);
+      void (* const halton_init)(ismael_halton*,int,ismael_mt64_state*);
+      void (* const halton_seek)(ismael_halton*,uint64_t);
+      void (* const halton_next)(ismael_halton*,double*);
+      void (* const halton_fill)(ismael_halton*,double*,size_t);
+      void (* const halton_free)(ismael_halton*);
+      double (* const philox)(uint64_t,uint64_t);
+      void (* const philox_fill)(uint64_t,uint64_t,double*,size_t);
       double (* const system)(int*);
       double* (* const bernoulli)(double,int,int);
+      void (* const bernoulli_batch)(double*,const double*,const int*,int,int);
       double* (* const distance)(double,int,int);
       double* (* const fourier)(double,int,int);
    } random;
    _Complex double (* const atoc)(const char*);
+   void (* const fft)(_Complex double*,int,int);
+   struct {
+      void (* const init)(ismael_fft_plan*,int);
+      void (* const exec)(ismael_fft_plan*,_Complex double*,int);
+      void (* const free)(ismael_fft_plan*);
+   } fft_plan;
    double** (* const FDP)(double*,int,int);
+   struct {
+      void (* const init)(ismael_moments*);
+      void (* const add)(ismael_moments*,const double*,size_t);
+      void (* const merge)(ismael_moments*,const ismael_moments*);
+      double (* const variance)(const ismael_moments*);
+      double (* const skewness)(const ismael_moments*);
+      double (* const kurtosis)(const ismael_moments*);
+   } moments;
+   struct {
+      void (* const init)(ismael_spectrum*,int,int);
+      void (* const add)(ismael_spectrum*,const double*);
+      double** (* const correlation)(const ismael_spectrum*);
+      double** (* const power)(const ismael_spectrum*);
+      void (* const free)(ismael_spectrum*);
+   } spectrum;
+   struct {
+      void (* const init)(ismael_histogram*,double,double,int);
+      void (* const init_edges)(ismael_histogram*,const double*,int);
+      void (* const add)(ismael_histogram*,const double*,size_t);
+      void (* const merge)(ismael_histogram*,const ismael_histogram*);
+      double** (* const pdf)(const ismael_histogram*);
+      void (* const free)(ismael_histogram*);
+   } histogram;
+   struct {
+      void (* const init)(ismael_alias*,double**,int,double);
+      double (* const next)(const ismael_alias*,ismael_mt64_state*);
+      void (* const fill)(const ismael_alias*,ismael_mt64_state*,double*,
+      size_t);
+      void (* const free)(ismael_alias*);
+   } alias;
+   struct {
+      int (* const count)(const double*,const double*,int,double);
+      void (* const eigenvalues)(const double*,const double*,int,int,int,
+      double*);
+      void (* const eigenvectors)(const double*,const double*,int,
+      const double*,int,double*);
+      double (* const participation)(const double*,int);
+   } tridiag;
+   struct {
+      void (* const init)(ismael_transfer*,const double*,int);
+      void (* const add)(ismael_transfer*,const double*,size_t);
+      void (* const lyapunov)(const ismael_transfer*,double*);
+      void (* const free)(ismael_transfer*);
+   } transfer;
+   struct {
+      void (* const lattice)(ismael_sparse*,int,const int*,const double*,bool);
+      double** (* const dos)(const ismael_sparse*,int,int,int,uint64_t);
+      void (* const free)(ismael_sparse*);
+   } kpm;
+   struct {
+      void (* const init)(ismael_ode*,int,int,ismael_ode_rhs,void*);
+      void (* const set)(ismael_ode*,double,const double*);
+      void (* const set_precision)(ismael_ode*,int);
+      int (* const step)(ismael_ode*);
+      int (* const evolve)(ismael_ode*,double);
+      void (* const interpolate)(ismael_ode*,double,double*);
+      int (* const evolve_event)(ismael_ode*,double,ismael_ode_event);
+      void (* const free)(ismael_ode*);
+      void (* const init_complex)(ismael_ode*,int,int,ismael_ode_rhs,void*);
+      void (* const set_complex)(ismael_ode*,double,const _Complex double*);
+      void (* const get_complex)(const ismael_ode*,_Complex double*);
+      void (* const hamiltonian)(double,const double*,double*,void*);
+      void (* const ensemble_init)(ismael_ode_ensemble*,int,int,int,
+      ismael_ode_batch_rhs,void*);
+      void (* const ensemble_set)(ismael_ode_ensemble*,double,const double*);
+      int (* const ensemble_evolve)(ismael_ode_ensemble*,double);
+      void (* const ensemble_free)(ismael_ode_ensemble*);
+      int (* const sweep)(int,int,int,ismael_ode_rhs,ismael_ode_setup,void*,
+      double,const double*,int,double*,uint64_t);
+   } ode;
    void (*error)(int,const char*);
 } __ismael_namespace;
 extern const __ismael_namespace ismael;
 
 #if (__STDC_VERSION__ >= __ISO_C11)
    #define ialloc(size, type) \
-   (type*)aligned_alloc(sizeof(type), (size_t)size * sizeof(type))
+   (type*)aligned_alloc(sizeof(type), (size_t)(size) * sizeof(type))
 #else
    #define ialloc(size, type) \
-   (type*)malloc((size_t)size * sizeof(type))
+   (type*)malloc((size_t)(size) * sizeof(type))
 #endif /* __ISO_C11 */
 
 #endif /* ISMAEL_H */
@@ -2,22 +2,48 @@
 
 #if (__STDC_VERSION__ >= 201112L) /* ISO C11 */
    #define alloc(size, type) \
-   (type*)aligned_alloc(sizeof(type), (size_t)size * sizeof(type))
+   (type*)aligned_alloc(sizeof(type), (size_t)(size) * sizeof(type))
 #else
    #define alloc(size, type) \
-   (type*)malloc((size_t)size * sizeof(type))
+   (type*)malloc((size_t)(size) * sizeof(type))
 #endif /* ISO C11 */
 
+#define LANES 8 /* independent minima and maxima, to vectorize */
+
 double **FDP(double *valor, int N, int particoes){
    double acrescimo;
    double janela;
    double **_fdp;
    double menor, maior;
+   long *contagem;
 
    {  /* Routine to get the bigger and the smaller values in the sample */
       menor = DBL_MAX;
       maior = -DBL_MAX;
-      for(int i = 0; i < N; ++i){
+      ISMAEL_OMP(omp parallel)
+      {
+         int i, l;
+         double m[LANES], M[LANES];
+         for(l = 0; l < LANES; ++l){
+            m[l] = DBL_MAX;
+            M[l] = -DBL_MAX;
+         }
+         ISMAEL_OMP(omp for)
+         for(i = 0; i < N / LANES; ++i){
+            for(l = 0; l < LANES; ++l){
+               m[l] = ((m[l]) < (valor[i*LANES+l]) ? (m[l]) : (valor[i*LANES+l]));
+               M[l] = ((M[l]) > (valor[i*LANES+l]) ? (M[l]) : (valor[i*LANES+l]));
+            }
+         }
+         ISMAEL_OMP(omp critical)
+         {
+            for(l = 0; l < LANES; ++l){
+               menor = ((menor) < (m[l]) ? (menor) : (m[l]));
+               maior = ((maior) > (M[l]) ? (maior) : (M[l]));
+            }
+         }
+      }
+      for(int i = (N / LANES) * LANES; i < N; ++i){
          menor = ((menor) < (valor[i]) ? (menor) : (valor[i]));
          maior = ((maior) > (valor[i]) ? (maior) : (valor[i]));
       }
@@ -28,23 +54,43 @@ double **FDP(double *valor, int N, int particoes){
    _fdp = alloc(2, double*);
    _fdp[0] = alloc(particoes, double);
    _fdp[1] = alloc(particoes, double);
-   
+   contagem = (long*)calloc((size_t)particoes, sizeof(long));
+
    /* Escrever os tipos de energia que ha nesse intervalo */
    for(int i = 0; i < particoes; ++i){
       _fdp[0][i] = menor + (i+1) * janela;
       _fdp[1][i] = 0.0;
    }
    /* ***
-      Rotina para contar a ocorrencia de cada tipo de energia
+      Rotina para contar a ocorrencia de cada tipo de energia.
+      O intervalo i e' o primeiro com valor <= _fdp[0][i], ele e' calculado
+      diretamente por (valor - menor) / janela e corrigido pelos extremos do
+      intervalo (arredondamento). Cada thread conta num histograma privado.
    *** */
-   acrescimo = 1.0 / (janela * (double)N);
-   for(int j = 0; j < N; ++j){
-      for(int i = 0; i < particoes; ++i){
-         if(valor[j] <= _fdp[0][i]){
-            _fdp[1][i] += acrescimo;
-            break;
-         }
+   ISMAEL_OMP(omp parallel)
+   {
+      int i;
+      double t;
+      long *conta = (long*)calloc((size_t)particoes, sizeof(long));
+      ISMAEL_OMP(omp for)
+      for(int j = 0; j < N; ++j){
+         t = (valor[j] - menor) / janela;
+         i = (t > 0.0) ? ((t < (double)particoes) ? (int)t : particoes - 1) : 0;
+         while((i > 0) && (valor[j] <= _fdp[0][i-1])) --i;
+         while((i < particoes) && (valor[j] > _fdp[0][i])) ++i;
+         if((i < particoes) && (valor[j] <= _fdp[0][i])) ++conta[i];
+      }
+      ISMAEL_OMP(omp critical)
+      {
+         for(i = 0; i < particoes; ++i) contagem[i] += conta[i];
       }
+      free(conta);
    }
+   acrescimo = 1.0 / (janela * (double)N);
+   for(int i = 0; i < particoes; ++i)
+      _fdp[1][i] = (double)contagem[i] * acrescimo;
+
+   free(contagem);
    return _fdp;
 }
+#undef LANES
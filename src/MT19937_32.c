@@ -13,11 +13,23 @@
    integer need to be the (nonzero) seed that initialize the generator and,
    for each call, this get the value of a pseudorandom 32 bit integer.
 
+   The funcions mt19937_32_init and mt19937_32_next do the same job but keep
+   the state of the generator in a ismael_mt32_state object of the caller,
+   then many independent generators can run at same time (e.g. one per
+   thread). With the same seed both use the same words, mt19937_32_next
+   multiply them by 2^-32.
+   The funcions mt19937_32_jump_init and mt19937_32_jump advance a state 2^k steps
+   without generate the numbers, mt19937_32_split use it to make P streams
+   that do not overlap from only one seed.
+
    References:
    * M. Matsumoto and T. Nishimura,
      "Mersenne Twister: A 623-Dimensionally Equidistributed Uniform
      Pseudo-Random Number Generator", ACM Transactions on Modeling and
      Computer Simulation, Vol. 8, No. 1, January 1998, pp 3--30.
+   * H. Haramoto, M. Matsumoto, T. Nishimura, F. Panneton and P. L'Ecuyer,
+     "Efficient Jump Ahead for F2-Linear Random Number Generators",
+     INFORMS Journal on Computing, Vol. 20, No. 3, 2008, pp 385--390.
    *****************************************************************************
    E-mail: ismaellxd@gmail.com
    Site: https://ismaeldamiao.github.io/
@@ -64,49 +76,310 @@
 #define MATRIX_MULTIPLY(original, new) \
 ((original) ^ ((new) >> 1) ^ mag01[(int)((new) & UINT64_C(0x1))])
 
-double mt19937_32(uint32_t *y){
+/* Initialize the state vector of one generator with a NONZERO seed,
+   if the seed is 0 then set it to 1999. */
+void mt19937_32_init(ismael_mt32_state *state, uint32_t seed){
+   int i;
+
+   if(seed == UINT32_C(0)) seed = UINT32_C(1999);
+   state->mt[0] = seed & UINT32_C(0xffffffff);
+   for(i = 1; i < N; ++i)
+      state->mt[i] = (69069 * state->mt[i-1]) & UINT32_C(0xffffffff);
+   state->mti = N; /* the first draw generate N words */
+}
+
+/* Generate N words at one time, in place. */
+void mt19937_32_generate(uint32_t *mt){
    int i;
    const int N1 = N-1, NM = N-M, MN = M-N;
-   static uint32_t mt[N]; /* the array for the state vector */
-   static int mti = N+1; /* mti==N+1 means mt[N] is not initialized */
-   static uint32_t mag01[2] = {0x0, MATRIX_A};
-
-   /* The following routine generate N words at one time */
-   if(mti >= N){
-
-      /* If mti == N+1 then the function is called by the first time and the
-         array mt[] need to be initialized.
-         The value pointed by 'y' in the firt call
-         is the seed of generator, if this value is 0 then set it to 1999. */
-      if(mti == N+1){ /* initializing the array with NONZERO seed */
-
-         if((*y) == UINT32_C(0)) *y = UINT32_C(1999);
-         mt[0] = (*y) & UINT32_C(0xffffffff);
-         for(mti = 1; mti < N; ++mti)
-            mt[mti] = (69069 * mt[mti-1]) & UINT32_C(0xffffffff);
-      }
+   static const uint32_t mag01[2] = {0x0, MATRIX_A};
+   uint32_t y;
 
-      /* With the array mt[] already initialized, generate the words. */
-      for(i = 0; i < NM; ++i){
-         *y = COMBINE_BITS(mt[i], mt[i+1]);
-         mt[i] = MATRIX_MULTIPLY(mt[i+M], *y);
-      }
-      for(; i < N1; ++i){
-         *y = COMBINE_BITS(mt[i], mt[i+1]);
-         mt[i] = MATRIX_MULTIPLY(mt[i + (MN)], *y);
-      }
-      *y = COMBINE_BITS(mt[i], mt[0]);
-      mt[N-1] = MATRIX_MULTIPLY(mt[M-1], *y);
-      mti = 0;
+   for(i = 0; i < NM; ++i){
+      y = COMBINE_BITS(mt[i], mt[i+1]);
+      mt[i] = MATRIX_MULTIPLY(mt[i+M], y);
+   }
+   for(; i < N1; ++i){
+      y = COMBINE_BITS(mt[i], mt[i+1]);
+      mt[i] = MATRIX_MULTIPLY(mt[i + (MN)], y);
+   }
+   y = COMBINE_BITS(mt[i], mt[0]);
+   mt[N-1] = MATRIX_MULTIPLY(mt[M-1], y);
+}
+
+/* Return the next tempered 32 bit word of the generator. */
+uint32_t mt19937_32_genrand(ismael_mt32_state *state){
+   uint32_t y;
+
+   if(state->mti >= N){
+      mt19937_32_generate(state->mt);
+      state->mti = 0;
    }
 
    /* Extract tempered value of mt[mti]. */
-   *y = mt[mti];
-   *y ^= ((*y) >> TEMPERING_U);
-   *y ^= ((*y) << TEMPERING_S) & TEMPERING_MASK_B;
-   *y ^= ((*y) << TEMPERING_T) & TEMPERING_MASK_C;
-   *y ^= ((*y) >> TEMPERING_L);
-   ++mti;
+   y = state->mt[state->mti++];
+   y ^= (y >> TEMPERING_U);
+   y ^= (y << TEMPERING_S) & TEMPERING_MASK_B;
+   y ^= (y << TEMPERING_T) & TEMPERING_MASK_C;
+   y ^= (y >> TEMPERING_L);
+
+   return y;
+}
+
+/* Reentrant version, each thread or replica own one state. The word
+   times 2^-32 is a double in [0, 1). */
+double mt19937_32_next(ismael_mt32_state *state){
+   return (double)mt19937_32_genrand(state) * 0x1.0p-32;
+}
+
+/* One step of the recurrence over a circular window of N words, the oldest
+   word w[*p] is replaced by the new one. */
+void mt19937_32_step(uint32_t *w, int *p){
+   static const uint32_t mag01[2] = {0x0, MATRIX_A};
+   const int i = *p;
+   uint32_t y;
+
+   y = COMBINE_BITS(w[i], w[(i+1) % N]);
+   w[i] = MATRIX_MULTIPLY(w[(i+M) % N], y);
+   *p = (i+1) % N;
+}
+
+/* Characteristic polynomial phi(x) of the generator, of degree 19937, the
+   bit i & 63 of phi[i >> 6] is the coefficient of x^i. It is computed by
+   mt_jump_berlekamp_massey from 2*19937 most significant bits of the words
+   of the generator (any seed give the same phi). */
+static const uint64_t mt19937_32_phi[312] = {
+   UINT64_C(0x0000000000000001), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000002000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000100), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0002000000000000), UINT64_C(0x0000080000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000004000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x2000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000200000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0100000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000008000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x4000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000200000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000010),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000008000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000400), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000020000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000020000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000002),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000020000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000002000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0020000000000000), UINT64_C(0x0000002000000000),
+   UINT64_C(0x0000000080000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000100),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000080000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000004000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000200000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000200000000000), UINT64_C(0x0002000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000010000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000020),
+   UINT64_C(0x0000000000000200), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000010000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000020000),
+   UINT64_C(0x0000000000200800), UINT64_C(0x0000000000008000),
+   UINT64_C(0x0200000000000000), UINT64_C(0x0100400000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000020000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000008000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000021),
+   UINT64_C(0x4000000000000000), UINT64_C(0x0000020000000000),
+   UINT64_C(0x0000010000000000), UINT64_C(0x0000000020000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0020000000000000),
+   UINT64_C(0x0000800000000000), UINT64_C(0x0000020000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000021000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000001000),
+   UINT64_C(0x0800000000000002), UINT64_C(0x0020000000000001),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000020000000000),
+   UINT64_C(0x0000000840000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000020000),
+   UINT64_C(0x0800000000000042), UINT64_C(0x0020000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000001000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000021000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000080),
+   UINT64_C(0x0000000000000002), UINT64_C(0x0020000000000001),
+   UINT64_C(0x0000040000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000002000), UINT64_C(0x0000000000000080),
+   UINT64_C(0x0000000000000002), UINT64_C(0x0021000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000001000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000001080000),
+   UINT64_C(0x0000000000002000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0840000000000002), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000020000000000),
+   UINT64_C(0x0000000042000000), UINT64_C(0x0000000000080000),
+   UINT64_C(0x0000000000002000), UINT64_C(0x1000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0021000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000080000000),
+   UINT64_C(0x0000000002000000), UINT64_C(0x0000000001000000),
+   UINT64_C(0x0000000000002000), UINT64_C(0x0000000000000004),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000002000000000), UINT64_C(0x0000000080000000),
+   UINT64_C(0x0000000002000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000002100), UINT64_C(0x1000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0001080000000000),
+   UINT64_C(0x0000002000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000002000000), UINT64_C(0x0000000000084000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0042000000000000), UINT64_C(0x0000080000000000),
+   UINT64_C(0x0000002000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000100000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000100), UINT64_C(0x0080000000000000),
+   UINT64_C(0x0002000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000002000000000), UINT64_C(0x0000000004000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x2000000000000000), UINT64_C(0x0080000000000000),
+   UINT64_C(0x0002000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000100000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000100000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x2000000000000008), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000004000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000200),
+   UINT64_C(0x0000000000000008), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000100000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000008000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0004000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000200000000)
+};
+
+/* Prepare a jump of 2^k steps, k >= 0, the jump object can be used for
+   many states. */
+void mt19937_32_jump_init(ismael_mt_jump *jump, int k){
+   if(k < 0)
+      ismael.error(EXIT_FAILURE,
+      "mt19937_32_jump_init: k can not be negative.\n");
+   jump->w = 32;
+   if(k >= 5) mt_jump_polynomial(jump, mt19937_32_phi, k);
+   else jump->k = k; /* less than 31 steps, jump step by step */
+}
+
+/* Advance the state 2^k steps, where k is the value given to jump_init. */
+void mt19937_32_jump(ismael_mt32_state *state, const ismael_mt_jump *jump){
+   int i, j, p = 0;
+   uint32_t w[N], acc[N];
+
+   if(jump->w != 32)
+      ismael.error(EXIT_FAILURE, "mt19937_32_jump: jump of other generator.\n");
+
+   /* The window of the next N words (before tempering) */
+   if(state->mti >= N){
+      mt19937_32_generate(state->mt);
+      state->mti = 0;
+   }
+   for(i = 0; i < N; ++i) w[i] = state->mt[i];
+   for(i = 0; i < state->mti; ++i) mt19937_32_step(w, &p);
+
+   if(jump->k < 5){
+      for(i = 0; i < (1 << jump->k); ++i) mt19937_32_step(w, &p);
+   }else{
+      /* Forget the 31 bits out of the recurrence */
+      for(i = 0; i < 31; ++i) mt19937_32_step(w, &p);
+      /* acc = sum_i p_i T^i(w) */
+      for(j = 0; j < N; ++j) acc[j] = 0;
+      for(i = 0; i < 19937; ++i){
+         if((jump->p[i >> 6] >> (i & 63)) & 1){
+            for(j = 0; j < N - p; ++j) acc[j] ^= w[p + j];
+            for(; j < N; ++j) acc[j] ^= w[p + j - N];
+         }
+         mt19937_32_step(w, &p);
+      }
+      for(j = 0; j < N; ++j) w[j] = acc[j];
+      p = 0;
+   }
+
+   for(j = 0; j < N; ++j) state->mt[j] = w[(p + j) % N];
+   state->mti = 0;
+}
+
+/* Initialize P states with streams spaced by 2^k steps, the stream i start
+   where the stream i-1 would be after 2^k draws. */
+void mt19937_32_split(ismael_mt32_state *streams, int P, uint32_t seed, int k){
+   int i;
+   ismael_mt_jump jump;
+
+   mt19937_32_jump_init(&jump, k);
+   mt19937_32_init(&streams[0], seed);
+   for(i = 1; i < P; ++i){
+      streams[i] = streams[i-1];
+      mt19937_32_jump(&streams[i], &jump);
+   }
+}
+
+double mt19937_32(uint32_t *y){
+   /* mti==N+1 means mt[N] is not initialized */
+   static ismael_mt32_state state = {{0}, N+1};
+
+   /* If mti == N+1 then the function is called by the first time and the
+      array mt[] need to be initialized.
+      The value pointed by 'y' in the firt call is the seed of generator. */
+   if(state.mti == N+1) mt19937_32_init(&state, *y);
+
+   *y = mt19937_32_genrand(&state);
 
    return ((double)(*y) / (double)UINT32_MAX);
 }
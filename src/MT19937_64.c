@@ -13,6 +13,16 @@
    integer need to be the (nonzero) seed that initialize the generator and,
    for each call, this get the value of a pseudorandom 64 bit integer.
 
+   The funcions mt19937_64_init and mt19937_64_next do the same job but keep
+   the state of the generator in a ismael_mt64_state object of the caller,
+   then many independent generators can run at same time (e.g. one per
+   thread). With the same seed both use the same words, mt19937_64_next
+   convert its 53 high bits to [0, 1).
+   The funcions mt19937_64_jump_init and mt19937_64_jump advance a state 2^k steps
+   without generate the numbers, mt19937_64_split use it to make P streams
+   that do not overlap from only one seed.
+   The funcion mt19937_64_fill generate a whole block of doubles in one call.
+
    References:
    * M. Matsumoto and T. Nishimura,
      "Mersenne Twister: A 623-Dimensionally Equidistributed Uniform
@@ -21,6 +31,9 @@
    * T. Nishimura,
      "Tables of 64-bit Mersenne Twisters", ACM Transactions on Modeling and
      Computer Simulation, Vol. 10, No 4, October 2000, Pages 348 –357.
+   * H. Haramoto, M. Matsumoto, T. Nishimura, F. Panneton and P. L'Ecuyer,
+     "Efficient Jump Ahead for F2-Linear Random Number Generators",
+     INFORMS Journal on Computing, Vol. 20, No. 3, 2008, pp 385--390.
    *****************************************************************************
    E-mail: ismaellxd@gmail.com
    Site: https://ismaeldamiao.github.io/
@@ -67,67 +80,399 @@
 /* This function combines the top bit of x with the bottom 63 bits of y. */
 #define COMBINE_BITS(x, y) (((x) & UPPER_MASK) | ((y) & LOWER_MASK))
 
-double mt19937_64(uint64_t *y){
+/* Initialize the state vector of one generator with a NONZERO seed,
+   if the seed is 0 then set it to 1999. */
+void mt19937_64_init(ismael_mt64_state *state, uint64_t seed){
+   int i;
+   uint64_t ux, lx;
+
+   if(seed == UINT64_C(0)) seed = UINT64_C(1999);
+   for(i = 0; i < N; ++i){
+      ux = seed & UINT64_C(0xFFFFFFFF00000000);
+      seed = UINT64_C(2862933555777941757) * seed + UINT64_C(1);
+      lx = seed >> 32;
+      seed = UINT64_C(2862933555777941757) * seed + UINT64_C(1);
+      state->mt[i] = ux | lx;
+   }
+   state->mti = N; /* the first draw generate N words */
+}
+
+/* Generate N words at one time, in place. */
+void mt19937_64_generate(uint64_t *mt){
    int i;
    const int N1 = N-1, NM2 = N-M2, NM1 = N-M1, NM0 = N-M0,
    M2N = M2-N, M1N = M1-N, M0N = M0-N;
-   static uint64_t mt[N]; /* the array for the state vector */
-   static int mti = N+1; /* mti==N+1 means mt[N] is not initialized */
-   static uint64_t mag01[2] = {0x0, MATRIX_A};
-
-   /* The following routine generate N words at one time */
-   if(mti >= N){
-
-      /* If mti == N+1 then the function is called by the first time and the
-         array mt[] need to be initialized.
-         The value pointed by 'y' in the firt call
-         is the seed of generator, if this value is 0 then set it to 1999. */
-      if(mti == N+1){ /* initializing the array with NONZERO seed */
-         uint64_t ux, lx;
-         if((*y) == UINT64_C(0)) *y = UINT64_C(1999);
-         for(mti = 0; mti < N; ++mti){
-            ux = (*y) & UINT64_C(0xFFFFFFFF00000000);
-            *y = UINT64_C(2862933555777941757) * (*y) + UINT64_C(1);
-            lx = (*y) >> 32;
-            *y = UINT64_C(2862933555777941757) * (*y) + UINT64_C(1);
-            mt[mti] = ux | lx;
-         }
-      }
+   static const uint64_t mag01[2] = {0x0, MATRIX_A};
+   uint64_t y;
+
+   for(i = 0; i < NM2; ++i){
+      y = COMBINE_BITS(mt[i], mt[i+1]);
+      mt[i] = (y >> 1) ^ mag01[(int)(y & UINT64_C(1))];
+      mt[i] ^= mt[i+M0] ^ mt[i+M1] ^ mt[i+M2];
+   }
+   for(; i < NM1; ++i){
+      y = COMBINE_BITS(mt[i], mt[i+1]);
+      mt[i] = (y >> 1) ^ mag01[(int)(y & UINT64_C(1))];
+      mt[i] ^= mt[i+M0] ^ mt[i+M1] ^ mt[i+M2N];
+   }
+   for(; i < NM0; ++i){
+      y = COMBINE_BITS(mt[i], mt[i+1]);
+      mt[i] = (y >> 1) ^ mag01[(int)(y & UINT64_C(1))];
+      mt[i] ^= mt[i+M0] ^ mt[i+M1N] ^ mt[i+M2N];
+   }
+   for(; i < N1; ++i){
+      y = COMBINE_BITS(mt[i], mt[i+1]);
+      mt[i] = (y >> 1) ^ mag01[(int)(y & UINT64_C(1))];
+      mt[i] ^= mt[i+M0N] ^ mt[i+M1N] ^ mt[i+M2N];
+   }
+   y = COMBINE_BITS(mt[i], mt[0]);
+   mt[i] = (y >> 1) ^ mag01[(int)(y & UINT64_C(1))];
+   mt[i] ^= mt[M0-1] ^ mt[M1-1] ^ mt[M2-1];
+}
 
-      /* With the array mt[] already initialized, generate the words. */
-      for(i = 0; i < NM2; ++i){
-         *y = COMBINE_BITS(mt[i], mt[i+1]);
-         mt[i] = ((*y) >> 1) ^ mag01[(int)((*y) & UINT64_C(1))];
-         mt[i] ^= mt[i+M0] ^ mt[i+M1] ^ mt[i+M2];
+/* Return the next tempered 64 bit word of the generator. */
+uint64_t mt19937_64_genrand(ismael_mt64_state *state){
+   uint64_t y;
+
+   if(state->mti >= N){
+      mt19937_64_generate(state->mt);
+      state->mti = 0;
+   }
+
+   /* Extract tempered value of mt[mti]. */
+   y = state->mt[state->mti++];
+   y ^= (y >> TEMPERING_U);
+   y ^= (y << TEMPERING_S) & TEMPERING_MASK_B;
+   y ^= (y << TEMPERING_T) & TEMPERING_MASK_C;
+   y ^= (y >> TEMPERING_L);
+
+   return y;
+}
+
+/* Write the next n tempered words in w, as n calls of genrand but the
+   tempering of a block is a loop that vectorize. */
+void mt19937_64_bits(ismael_mt64_state *state, uint64_t *w, size_t n){
+   int i, m;
+   uint64_t y;
+
+   while(n > 0){
+      if(state->mti >= N){
+         mt19937_64_generate(state->mt);
+         state->mti = 0;
       }
-      for(; i < NM1; ++i){
-         *y = COMBINE_BITS(mt[i], mt[i+1]);
-         mt[i] = ((*y) >> 1) ^ mag01[(int)((*y) & UINT64_C(1))];
-         mt[i] ^= mt[i+M0] ^ mt[i+M1] ^ mt[i+M2N];
+      m = N - state->mti;
+      if((size_t)m > n) m = (int)n;
+      for(i = 0; i < m; ++i){
+         y = state->mt[state->mti + i];
+         y ^= (y >> TEMPERING_U);
+         y ^= (y << TEMPERING_S) & TEMPERING_MASK_B;
+         y ^= (y << TEMPERING_T) & TEMPERING_MASK_C;
+         y ^= (y >> TEMPERING_L);
+         w[i] = y;
       }
-      for(; i < NM0; ++i){
-         *y = COMBINE_BITS(mt[i], mt[i+1]);
-         mt[i] = ((*y) >> 1) ^ mag01[(int)((*y) & UINT64_C(1))];
-         mt[i] ^= mt[i+M0] ^ mt[i+M1N] ^ mt[i+M2N];
+      state->mti += m;
+      w += m;
+      n -= (size_t)m;
+   }
+}
+
+/* Reentrant version, each thread or replica own one state. The 53 high
+   bits of the word give a double in [0, 1), the same of mt19937_64_fill. */
+double mt19937_64_next(ismael_mt64_state *state){
+   return (double)(int64_t)(mt19937_64_genrand(state) >> 11) * 0x1.0p-53;
+}
+
+/* Temper n words of mt[] and convert them to doubles in [0, 1) with 53 bits
+   of resolution. Instead of a division each 53 bits integer is splited in
+   two halfs that are converted by the exponent trick (2^52 + u has the bits
+   of u in the mantissa), without branches the loop vectorize. */
+void mt19937_64_todouble(const uint64_t *mt, double *x, int n){
+   int i;
+   uint64_t y;
+   union { uint64_t u; double d; } hi, lo;
+
+   for(i = 0; i < n; ++i){
+      y = mt[i];
+      y ^= (y >> TEMPERING_U);
+      y ^= (y << TEMPERING_S) & TEMPERING_MASK_B;
+      y ^= (y << TEMPERING_T) & TEMPERING_MASK_C;
+      y ^= (y >> TEMPERING_L);
+      y >>= 11;
+      hi.u = (y >> 32) | UINT64_C(0x4330000000000000);
+      lo.u = (y & UINT64_C(0xffffffff)) | UINT64_C(0x4330000000000000);
+      x[i] = ((hi.d - 0x1p52) * 0x1p32 + (lo.d - 0x1p52)) * 0x1p-53;
+   }
+}
+
+/* Fill x[0], ..., x[n-1] with doubles in [0, 1), the state is regenerated
+   in place block by block. The order of the words is the same of
+   mt19937_64_next, then calls of both can be mixed. */
+void mt19937_64_fill(ismael_mt64_state *state, double *x, size_t n){
+   size_t m;
+
+   while(n > 0){
+      if(state->mti >= N){
+         mt19937_64_generate(state->mt);
+         state->mti = 0;
       }
-      for(; i < N1; ++i){
-         *y = COMBINE_BITS(mt[i], mt[i+1]);
-         mt[i] = ((*y) >> 1) ^ mag01[(int)((*y) & UINT64_C(1))];
-         mt[i] ^= mt[i+M0N] ^ mt[i+M1N] ^ mt[i+M2N];
+      m = (size_t)(N - state->mti);
+      if(m > n) m = n;
+      mt19937_64_todouble(state->mt + state->mti, x, (int)m);
+      state->mti += (int)m;
+      x += m;
+      n -= m;
+   }
+}
+
+/* One step of the recurrence over a circular window of N words, the oldest
+   word w[*p] is replaced by the new one. */
+void mt19937_64_step(uint64_t *w, int *p){
+   static const uint64_t mag01[2] = {0x0, MATRIX_A};
+   const int i = *p;
+   uint64_t y;
+
+   y = COMBINE_BITS(w[i], w[(i+1) % N]);
+   w[i] = (y >> 1) ^ mag01[(int)(y & UINT64_C(1))];
+   w[i] ^= w[(i+M0) % N] ^ w[(i+M1) % N] ^ w[(i+M2) % N];
+   *p = (i+1) % N;
+}
+
+/* Characteristic polynomial phi(x) of the generator, of degree 19937, the
+   bit i & 63 of phi[i >> 6] is the coefficient of x^i. It is computed by
+   mt_jump_berlekamp_massey from 2*19937 most significant bits of the words
+   of the generator (any seed give the same phi). */
+static const uint64_t mt19937_64_phi[312] = {
+   UINT64_C(0x0000000000000001), UINT64_C(0x4000000000000000),
+   UINT64_C(0x2000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000400000200000), UINT64_C(0x0400200040000000),
+   UINT64_C(0x0240000000000000), UINT64_C(0x8100000000000021),
+   UINT64_C(0x0000040000024000), UINT64_C(0x0001024004800000),
+   UINT64_C(0x1004800100000000), UINT64_C(0x0900000004000002),
+   UINT64_C(0x0000000002000480), UINT64_C(0x0002100400090000),
+   UINT64_C(0x0402090010000400), UINT64_C(0x4010000000000200),
+   UINT64_C(0x2000800210040208), UINT64_C(0x0000040208041000),
+   UINT64_C(0x0308641000200080), UINT64_C(0x1008300040011004),
+   UINT64_C(0x0040010000020824), UINT64_C(0x8000060864104821),
+   UINT64_C(0x0024124820104000), UINT64_C(0x4821904000800002),
+   UINT64_C(0x4020808106004412), UINT64_C(0x8102004402483490),
+   UINT64_C(0x0402182590412080), UINT64_C(0x0490492080410700),
+   UINT64_C(0x2080410300440209), UINT64_C(0x0681040618051049),
+   UINT64_C(0x0208051009209041), UINT64_C(0x1008609041028004),
+   UINT64_C(0x1041228085061804), UINT64_C(0x8085000805100820),
+   UINT64_C(0x1a04101860104122), UINT64_C(0x082010c020814505),
+   UINT64_C(0xc0218005018a0010), UINT64_C(0x45040a0014386010),
+   UINT64_C(0x0114802010482180), UINT64_C(0x681048608003008b),
+   UINT64_C(0x229061048a0094b0), UINT64_C(0x0002109400290048),
+   UINT64_C(0x1431290058e19061), UINT64_C(0x0058049061244001),
+   UINT64_C(0xb061a3c201040128), UINT64_C(0xc240c430080058c1),
+   UINT64_C(0x000800d80cb001a6), UINT64_C(0xd8c8b04161c35584),
+   UINT64_C(0x31661145c4910800), UINT64_C(0xc5848d08001005b0),
+   UINT64_C(0x2b0110c1b0536102), UINT64_C(0x0ca1216612c48499),
+   UINT64_C(0x6122c58585091010), UINT64_C(0x8599491112488001),
+   UINT64_C(0x10123020114610c4), UINT64_C(0x2411c322c5058509),
+   UINT64_C(0x9084e5984b101260), UINT64_C(0x8489109230a540c4),
+   UINT64_C(0xb261860041a18005), UINT64_C(0x5144c30163184910),
+   UINT64_C(0x21010ca910b23124), UINT64_C(0x4c113268640141a0),
+   UINT64_C(0x39644046c0810010), UINT64_C(0xc180800004aa0032),
+   UINT64_C(0x01910401906a4650), UINT64_C(0x005018e444c4c001),
+   UINT64_C(0x105441a1200184a0), UINT64_C(0xe18160110d00004b),
+   UINT64_C(0x042b204018801444), UINT64_C(0x104e3a1401a88140),
+   UINT64_C(0x3504620133110401), UINT64_C(0xc15104a000901888),
+   UINT64_C(0xa201004e10141128), UINT64_C(0x1900351062205011),
+   UINT64_C(0x0118405104822100), UINT64_C(0xd091a801c04d9a14),
+   UINT64_C(0x01201a8891006280), UINT64_C(0x80919118c0508481),
+   UINT64_C(0xe222b101ab01404e), UINT64_C(0x0442a12018801491),
+   UINT64_C(0x604e2a1500114051), UINT64_C(0x0580eb812021a881),
+   UINT64_C(0xa040044101691a08), UINT64_C(0x8400e90ee0161118),
+   UINT64_C(0x995014906a23d121), UINT64_C(0xc1b880d10469a168),
+   UINT64_C(0x50a0ac80980cfa15), UINT64_C(0x01791b5901a0e880),
+   UINT64_C(0x2131f03921508540), UINT64_C(0x6f6b71218501698c),
+   UINT64_C(0x04cba128139011b0), UINT64_C(0x7884aa102231ca50),
+   UINT64_C(0x21a06dc06091ac00), UINT64_C(0x004190c281511b38),
+   UINT64_C(0xbb01c08ca023b230), UINT64_C(0x93a830b06e4ac181),
+   UINT64_C(0xc2128ac188e3a141), UINT64_C(0xc010990082861a11),
+   UINT64_C(0x83630b2104006e40), UINT64_C(0x65a47212004419e2),
+   UINT64_C(0x6caae5819a01020e), UINT64_C(0x086ba1630b2cb510),
+   UINT64_C(0x020ece14011ac044), UINT64_C(0x14812e2876119381),
+   UINT64_C(0x2055886a03930b84), UINT64_C(0xba81130e64b5101b),
+   UINT64_C(0x88acb5902caa5511), UINT64_C(0x613b80550041a112),
+   UINT64_C(0x7410b201c08f6614), UINT64_C(0x0b6109a514412ca8),
+   UINT64_C(0xcbb4303b2054004a), UINT64_C(0x24aa7510ba89710e),
+   UINT64_C(0x00c0a17019289450), UINT64_C(0x601ae015413b0a54),
+   UINT64_C(0x35c124205790b081), UINT64_C(0x8a5490cb8bc10900),
+   UINT64_C(0xb109500acab5d03b), UINT64_C(0x9aa8b5d0248a5420),
+   UINT64_C(0xa103025400ca2151), UINT64_C(0x7532b281d59b4817),
+   UINT64_C(0xab748b2114412ca0), UINT64_C(0xcbb430038ac510c8),
+   UINT64_C(0x248ae401b009540a), UINT64_C(0x812a03751ba1b550),
+   UINT64_C(0x559a411751030845), UINT64_C(0xb4d12428c5109001),
+   UINT64_C(0x80c480282b140b08), UINT64_C(0x9a89950acab44003),
+   UINT64_C(0x18a035c024a24431), UINT64_C(0x712b284471208334),
+   UINT64_C(0xe5629201841a481f), UINT64_C(0xab2588a8be512c8a),
+   UINT64_C(0x4ab4603b80556028), UINT64_C(0x32a0d4519a29350a),
+   UINT64_C(0xd080031598a11440), UINT64_C(0x259a411e51292254),
+   UINT64_C(0x9ed12202d141b029), UINT64_C(0xa851d0882b44a88a),
+   UINT64_C(0xa221d50a4834c039), UINT64_C(0x380214c43288f261),
+   UINT64_C(0xf5a92250408803f4), UINT64_C(0xf171a229751acabe),
+   UINT64_C(0x2b740b0a9555228a), UINT64_C(0x881f6439a3d15088),
+   UINT64_C(0xa8017251a201558b), UINT64_C(0xd18801d41a023544),
+   UINT64_C(0xf59a80bf553b22d0), UINT64_C(0x95d52802f540a0a9),
+   UINT64_C(0x2255d0a883542b2a), UINT64_C(0xa0215443889f643a),
+   UINT64_C(0x702235c628007f61), UINT64_C(0x75ba22dd71a82bf5),
+   UINT64_C(0xf560b0a9d55288af), UINT64_C(0x815443aa0f552882),
+   UINT64_C(0x8007451a21d570b8), UINT64_C(0x9881df41a00174c3),
+   UINT64_C(0x50a80bd5d2a28d45), UINT64_C(0xf5d280af542a289d),
+   UINT64_C(0x07d40a88b5c1b209), UINT64_C(0x2095c4390976e382),
+   UINT64_C(0x238155438087753a), UINT64_C(0x72a28d551a82bf75),
+   UINT64_C(0xf403289d54a88af4), UINT64_C(0x95673a00f452882f),
+   UINT64_C(0x0077d1a20d548308), UINT64_C(0x888dd512220544b8),
+   UINT64_C(0x82802f552aa8d551), UINT64_C(0xd50808f440a389d5),
+   UINT64_C(0x74c0a90b5433208d), UINT64_C(0x09546b8085641820),
+   UINT64_C(0x2805d418883e7182), UINT64_C(0x0a289f51a82bf57a),
+   UINT64_C(0x603289556a88bf65), UINT64_C(0xf453a03d658880b5),
+   UINT64_C(0x1557ba2015403089), UINT64_C(0x881fd1220254c200),
+   UINT64_C(0x2802d553aa2d75b8), UINT64_C(0xd0800f448a0adf51),
+   UINT64_C(0xc50a8275c033a855), UINT64_C(0x55c4b988d661a225),
+   UINT64_C(0x2254408801e43802), UINT64_C(0xa229751a82bff5a2),
+   UINT64_C(0x0b0a9555288bf571), UINT64_C(0x663aa3d550880b74),
+   UINT64_C(0x56d3a201558b8a1d), UINT64_C(0x01d41a023544a001),
+   UINT64_C(0x80bf553a22d45388), UINT64_C(0x2800f542a1adf59a),
+   UINT64_C(0xd0a9a7542b2a95d5), UINT64_C(0x5443889d643a2255),
+   UINT64_C(0x35c428005f61a025), UINT64_C(0x22dd71a82bf57222),
+   UINT64_C(0xb0a9d55288af753a), UINT64_C(0x43aa0f55a880f560),
+   UINT64_C(0x471a20d570b8a174), UINT64_C(0xdfc1a00174c38005),
+   UINT64_C(0x0bd5d2a28d459880), UINT64_C(0x808f542a289d50a8),
+   UINT64_C(0x0a8ab541b309f5d2), UINT64_C(0xc4390956e38207d4),
+   UINT64_C(0x55438085753a2295), UINT64_C(0x8d551a82bf752201),
+   UINT64_C(0x289d54a80af47282), UINT64_C(0x3a00f552880ff40b),
+   UINT64_C(0x51820d548b0a9565), UINT64_C(0xd51a201544b80056),
+   UINT64_C(0x3f552a28d5d1888d), UINT64_C(0x8af4408289d58a00),
+   UINT64_C(0xa82b543b209dd528), UINT64_C(0x43009564382075c0),
+   UINT64_C(0xd438885f71a22954), UINT64_C(0xdd51a82bf5722015),
+   UINT64_C(0x89d54200af652828), UINT64_C(0xa00d75a882f560b2),
+   UINT64_C(0x18205540b0a97453), UINT64_C(0x51a22354c3800545),
+   UINT64_C(0xd552a20d7598885f), UINT64_C(0x2f44080a9dd1a003),
+   UINT64_C(0x80b5c0b2a9d5d288), UINT64_C(0x30895463a205d50a),
+   UINT64_C(0x438805741a0215c4), UINT64_C(0xd51a821ff5222354),
+   UINT64_C(0x9d552082f572a20d), UINT64_C(0xa8d5528a2f740a0a),
+   UINT64_C(0xa205558a88b5643a), UINT64_C(0x1a02354438085441),
+   UINT64_C(0x552a2854c1880554), UINT64_C(0xf550a089559a801f),
+   UINT64_C(0xab540a2a9dd5280a), UINT64_C(0x88b5443a28d5c0a8),
+   UINT64_C(0x38085571a0015402), UINT64_C(0x41a80175122235c4),
+   UINT64_C(0x5512880f752a2855), UINT64_C(0x8d55288af570a089),
+   UINT64_C(0x28d540a8ab7402aa), UINT64_C(0xa001748280a5641a),
+   UINT64_C(0x12a2054418885551), UINT64_C(0x550a2215c1a82155),
+   UINT64_C(0xb550a2097592800f), UINT64_C(0x2b5402828dd50a82),
+   UINT64_C(0x80a5d41a2895d028), UINT64_C(0x1a88156122015502),
+   UINT64_C(0x41282074128205d4), UINT64_C(0x5512880ff50a2215),
+   UINT64_C(0x8d550a02b5702a08), UINT64_C(0x289550282a540082),
+   UINT64_C(0x2a00558088a5741a), UINT64_C(0x108221541a0a1541),
+   UINT64_C(0x550a2815c128a074), UINT64_C(0xb55028085590a80b),
+   UINT64_C(0xaa5500a28955020a), UINT64_C(0xa8a154122895c028),
+   UINT64_C(0x120a057128005500), UINT64_C(0x4128a07510a22154),
+   UINT64_C(0x5510a00b7502a805), UINT64_C(0x8955028aa5700808),
+   UINT64_C(0xa8854008aa5500a2), UINT64_C(0x08001580a0817412),
+   UINT64_C(0x10a2015412820551), UINT64_C(0x5502a805c10aa035),
+   UINT64_C(0xa5400a081590200b), UINT64_C(0xaa15002289550282),
+   UINT64_C(0x20805412a885c00a), UINT64_C(0x128205610a001500),
+   UINT64_C(0x410aa035102a0054), UINT64_C(0x1510280a5500a805),
+   UINT64_C(0x88550082a5600a08), UINT64_C(0xa881400aa815002a),
+   UINT64_C(0x0a00158028005410), UINT64_C(0x102a805410a20141),
+   UINT64_C(0x5400a8014102a035), UINT64_C(0xa14002081590280a),
+   UINT64_C(0xa805002a885400a2), UINT64_C(0x28005410a8814002),
+   UINT64_C(0x10a2016102800500), UINT64_C(0x4102a025100a8054),
+   UINT64_C(0x0510080a5400a801), UINT64_C(0x881400a281600288),
+   UINT64_C(0xa8814002a005000a), UINT64_C(0x028805800a001410),
+   UINT64_C(0x000a801410220141), UINT64_C(0x140028014102a025),
+   UINT64_C(0x8040028805800a0a), UINT64_C(0xa005000a88140022),
+   UINT64_C(0x0a00141020804002), UINT64_C(0x1022004100880500),
+   UINT64_C(0x4100a025000a8014), UINT64_C(0x01000a0814002000),
+   UINT64_C(0x8814002200400088), UINT64_C(0x200040008001000a),
+   UINT64_C(0x0088010002001410), UINT64_C(0x0002801410220040),
+   UINT64_C(0x0400200040008021), UINT64_C(0x0040008801000208),
+   UINT64_C(0x8001000208040022), UINT64_C(0x0200041000004000),
+   UINT64_C(0x1002004000880100), UINT64_C(0x0000800100020004),
+   UINT64_C(0x0100020004000000), UINT64_C(0x0004000000000088),
+   UINT64_C(0x0000000000010002), UINT64_C(0x0008010002000400),
+   UINT64_C(0x0002000400000000), UINT64_C(0x0400000000000000),
+   UINT64_C(0x0000000000000200), UINT64_C(0x0000000000040000),
+   UINT64_C(0x0000040000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+   UINT64_C(0x0000000000000000), UINT64_C(0x0000000200000000)
+};
+
+/* Prepare a jump of 2^k steps, k >= 0, the jump object can be used for
+   many states. */
+void mt19937_64_jump_init(ismael_mt_jump *jump, int k){
+   if(k < 0)
+      ismael.error(EXIT_FAILURE,
+      "mt19937_64_jump_init: k can not be negative.\n");
+   jump->w = 64;
+   if(k >= 5) mt_jump_polynomial(jump, mt19937_64_phi, k);
+   else jump->k = k; /* less than 31 steps, jump step by step */
+}
+
+/* Advance the state 2^k steps, where k is the value given to jump_init. */
+void mt19937_64_jump(ismael_mt64_state *state, const ismael_mt_jump *jump){
+   int i, j, p = 0;
+   uint64_t w[N], acc[N];
+
+   if(jump->w != 64)
+      ismael.error(EXIT_FAILURE, "mt19937_64_jump: jump of other generator.\n");
+
+   /* The window of the next N words (before tempering) */
+   if(state->mti >= N){
+      mt19937_64_generate(state->mt);
+      state->mti = 0;
+   }
+   for(i = 0; i < N; ++i) w[i] = state->mt[i];
+   for(i = 0; i < state->mti; ++i) mt19937_64_step(w, &p);
+
+   if(jump->k < 5){
+      for(i = 0; i < (1 << jump->k); ++i) mt19937_64_step(w, &p);
+   }else{
+      /* Forget the 31 bits out of the recurrence */
+      for(i = 0; i < 31; ++i) mt19937_64_step(w, &p);
+      /* acc = sum_i p_i T^i(w) */
+      for(j = 0; j < N; ++j) acc[j] = 0;
+      for(i = 0; i < 19937; ++i){
+         if((jump->p[i >> 6] >> (i & 63)) & 1){
+            for(j = 0; j < N - p; ++j) acc[j] ^= w[p + j];
+            for(; j < N; ++j) acc[j] ^= w[p + j - N];
+         }
+         mt19937_64_step(w, &p);
       }
-      *y = COMBINE_BITS(mt[i], mt[0]);
-      mt[i] = ((*y) >> 1) ^ mag01[(int)((*y) & UINT64_C(1))];
-      mt[i] ^= mt[M0-1] ^ mt[M1-1] ^ mt[M2-1];
-      mti = 0;
+      for(j = 0; j < N; ++j) w[j] = acc[j];
+      p = 0;
    }
 
-   /* Extract tempered value of mt[mti]. */
-   *y = mt[mti];
-   *y ^= ((*y) >> TEMPERING_U);
-   *y ^= ((*y) << TEMPERING_S) & TEMPERING_MASK_B;
-   *y ^= ((*y) << TEMPERING_T) & TEMPERING_MASK_C;
-   *y ^= ((*y) >> TEMPERING_L);
-   ++mti;
+   for(j = 0; j < N; ++j) state->mt[j] = w[(p + j) % N];
+   state->mti = 0;
+}
+
+/* Initialize P states with streams spaced by 2^k steps, the stream i start
+   where the stream i-1 would be after 2^k draws. */
+void mt19937_64_split(ismael_mt64_state *streams, int P, uint64_t seed, int k){
+   int i;
+   ismael_mt_jump jump;
+
+   mt19937_64_jump_init(&jump, k);
+   mt19937_64_init(&streams[0], seed);
+   for(i = 1; i < P; ++i){
+      streams[i] = streams[i-1];
+      mt19937_64_jump(&streams[i], &jump);
+   }
+}
+
+double mt19937_64(uint64_t *y){
+   /* mti==N+1 means mt[N] is not initialized */
+   static ismael_mt64_state state = {{0}, N+1};
+
+   /* If mti == N+1 then the function is called by the first time and the
+      array mt[] need to be initialized.
+      The value pointed by 'y' in the firt call is the seed of generator. */
+   if(state.mti == N+1) mt19937_64_init(&state, *y);
+
+   *y = mt19937_64_genrand(&state);
 
    return ((double)(*y) / (double)UINT64_MAX);
 }
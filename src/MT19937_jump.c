@@ -0,0 +1,156 @@
+/* *****************************************************************************
+   Arithmetic of polynomials over GF(2) used to jump ahead the Mersenne
+   Twister generators.
+
+   The words of the generators obey a linear recurrence over GF(2) whose
+   characteristic polynomial phi(x) has degree 19937. To advance the
+   generator J steps we compute p(x) = x^J mod phi(x) and then the new state
+   is sum_i p_i T^i(state), where T is one step of the generator. The
+   polynomial phi(x) of each generator is a table in MT19937_64.c and
+   MT19937_32.c (computed once by the Berlekamp-Massey algorithm from
+   2*19937 bits of the generator, with mt_jump_berlekamp_massey), and
+   x^(2^k) mod phi(x) is computed by k squarings.
+
+   The state vector of the generators have 31 bits more than 19937, these
+   bits are forgotten after 31 steps, so the jump first advance 31 steps
+   and then apply p(x) = x^(2^k - 31) mod phi(x).
+
+   References:
+   * H. Haramoto, M. Matsumoto, T. Nishimura, F. Panneton and P. L'Ecuyer,
+     "Efficient Jump Ahead for F2-Linear Random Number Generators",
+     INFORMS Journal on Computing, Vol. 20, No. 3, 2008, pp 385--390.
+   * J. L. Massey, "Shift-register synthesis and BCH decoding",
+     IEEE Transactions on Information Theory, Vol. 15, No. 1, 1969, pp 122--127.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include <stdint.h> /* Use C99 or latter */
+
+#define DEG 19937 /* degree of phi(x) */
+#define WORDS 626 /* words of 64 bit to keep 2*DEG bits and some more */
+
+#define GET_BIT(v, i) ((int)(((v)[(i) >> 6] >> ((i) & 63)) & 1))
+#define FLIP_BIT(v, i) ((v)[(i) >> 6] ^= UINT64_C(1) << ((i) & 63))
+
+/* Compute a ^= b * x^m, where a have na words and b have nb words. */
+void mt_jump_shift_xor(uint64_t *a, int na, const uint64_t *b, int nb, int m){
+   int i, q = m >> 6, r = m & 63;
+
+   for(i = 0; (i < nb) && (i + q < na); ++i){
+      a[i + q] ^= b[i] << r;
+      if((r != 0) && (i + q + 1 < na)) a[i + q + 1] ^= b[i] >> (64 - r);
+   }
+}
+
+/* Berlekamp-Massey algorithm. Given the n bits of s (s_0 is the bit 0 of
+   s[0]) compute the characteristic polynomial phi(x) of the shortest linear
+   recurrence of the sequence and return its degree. */
+int mt_jump_berlekamp_massey(const uint64_t *s, int n, uint64_t *phi){
+   int i, j, q, r, L = 0, m = 1, off, d;
+   uint64_t C[WORDS], B[WORDS], T[WORDS], R[WORDS + 1], w;
+
+   for(i = 0; i < WORDS; ++i) C[i] = B[i] = R[i] = UINT64_C(0);
+   R[WORDS] = UINT64_C(0);
+   C[0] = B[0] = UINT64_C(1);
+
+   /* R is s reversed, then sum_{i=0}^{L} C_i s_{j-i} is a product of C with
+      the bits of R starting at off = n - 1 - j. */
+   for(i = 0; i < n; ++i) if(GET_BIT(s, i)) FLIP_BIT(R, n - 1 - i);
+
+   for(j = 0; j < n; ++j){
+      /* The discrepancy */
+      off = n - 1 - j;
+      q = off >> 6;
+      r = off & 63;
+      w = UINT64_C(0);
+      for(i = 0; i <= (L >> 6); ++i){
+         if(r == 0) w ^= C[i] & R[q + i];
+         else w ^= C[i] & ((R[q + i] >> r) | (R[q + i + 1] << (64 - r)));
+      }
+      for(i = 32; i > 0; i >>= 1) w ^= w >> i;
+      d = (int)(w & 1);
+
+      if(d == 0){
+         ++m;
+      }else if(2 * L <= j){
+         for(i = 0; i < WORDS; ++i) T[i] = C[i];
+         mt_jump_shift_xor(C, WORDS, B, WORDS, m);
+         L = j + 1 - L;
+         for(i = 0; i < WORDS; ++i) B[i] = T[i];
+         m = 1;
+      }else{
+         mt_jump_shift_xor(C, WORDS, B, WORDS, m);
+         ++m;
+      }
+   }
+
+   /* phi(x) = x^L C(1/x) */
+   for(i = 0; i < WORDS; ++i) phi[i] = UINT64_C(0);
+   for(i = 0; i <= L; ++i) if(GET_BIT(C, i)) FLIP_BIT(phi, L - i);
+
+   return L;
+}
+
+/* Compute x^(2^k - 31) mod phi(x), the result have DEG bits and is keept in
+   jump->p. */
+void mt_jump_polynomial(ismael_mt_jump *jump, const uint64_t *phi, int k){
+   int i, j;
+   uint64_t a[WORDS], w, lo, hi;
+   const int nw = (DEG + 64) / 64;
+
+   for(i = 0; i < WORDS; ++i) a[i] = UINT64_C(0);
+   a[0] = UINT64_C(2); /* x */
+
+   for(j = 0; j < k; ++j){
+      /* Over GF(2) the square of sum_i a_i x^i is sum_i a_i x^(2i) */
+      for(i = nw - 1; i >= 0; --i){
+         w = a[i];
+         lo = hi = UINT64_C(0);
+         for(int b = 0; b < 32; ++b){
+            lo |= ((w >> b) & 1) << (2 * b);
+            hi |= ((w >> (b + 32)) & 1) << (2 * b);
+         }
+         a[2 * i] = lo;
+         a[2 * i + 1] = hi;
+      }
+      /* Reduction modulo phi(x) */
+      for(i = 2 * DEG; i >= DEG; --i)
+         if(GET_BIT(a, i)) mt_jump_shift_xor(a, WORDS, phi, nw, i - DEG);
+   }
+
+   /* Multiply by x^(-31), note that x^(-1) p(x) = (p(x) + phi(x)) / x
+      if p(0) = 1, because phi(0) = 1. */
+   for(j = 0; j < 31; ++j){
+      if(a[0] & 1) for(i = 0; i < nw; ++i) a[i] ^= phi[i];
+      for(i = 0; i < nw; ++i)
+         a[i] = (a[i] >> 1) | ((i + 1 < nw) ? (a[i + 1] << 63) : UINT64_C(0));
+   }
+
+   for(i = 0; i < 312; ++i) jump->p[i] = a[i];
+   jump->k = k;
+}
+#undef DEG
+#undef WORDS
+#undef GET_BIT
+#undef FLIP_BIT
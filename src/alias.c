@@ -0,0 +1,164 @@
+/* *****************************************************************************
+   Sampler of the density given by FDP (or histogram.pdf), by the alias
+   method of Walker, to draw new numbers from a measured distribution.
+
+   The weight of the bin i is p_i = density_i * width_i. The table is built
+   once in O(bins) (Vose): each bin i keep the probability q_i and a second
+   bin a_i, such that to choose i uniformly and accept it with probability
+   q_i, else take a_i, gives the bin i with probability p_i. In the bin the
+   number is uniform, then the sample have the same density of the
+   histogram (constant by parts).
+
+   To draw a number only one uniform U of mt64 is used: V = U bins, the bin
+   is i = floor(V) and f = V - i is the test of q_i, the rest of f (f/q_i or
+   (f - q_i)/(1 - q_i), also uniform) is the position in the bin. No
+   binary search is made, the cost is O(1) for any number of bins.
+
+   As FDP give only the right edges, the left edge lo of the first bin is
+   given by the caller (the minimum of the sample for FDP, h.edges[0] for
+   histogram.pdf), then the bins may have any width.
+
+   Reference:
+   * M. D. Vose, "A Linear Algorithm For Generating Random Numbers With a
+     Given Distribution", IEEE Transactions on Software Engineering, Vol. 17,
+     No. 9, 1991.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+/* Table of the density pdf[1][i] in the bins of right edge pdf[0][i], the
+   first bin start in lo */
+void alias_init(ismael_alias *a, double **pdf, int bins, double lo){
+   int i, j, ns, nl, *small, *large;
+   double sum, *p;
+
+   if(bins < 1)
+      ismael.error(EXIT_FAILURE, "alias_init: at least 1 bin is need.\n");
+   a->bins = bins;
+   a->edges = ialloc(bins + 1, double);
+   a->q = ialloc(bins, double);
+   a->alias = ialloc(bins, int);
+   a->c = ialloc(4 * bins, double);
+   p = ialloc(bins, double);
+   small = ialloc(bins, int);
+   large = ialloc(bins, int);
+   if((a->edges == NULL) || (a->q == NULL) || (a->alias == NULL) ||
+   (a->c == NULL) || (p == NULL) || (small == NULL) || (large == NULL))
+      ismael.error(EXIT_FAILURE, "alias_init: out of memory.\n");
+
+   a->edges[0] = lo;
+   for(i = 0; i < bins; ++i) a->edges[i+1] = pdf[0][i];
+   sum = 0.0;
+   for(i = 0; i < bins; ++i){
+      if(!(pdf[1][i] >= 0.0) || !(a->edges[i+1] > a->edges[i]))
+         ismael.error(EXIT_FAILURE, "alias_init: the density must be "
+         "positive and the edges increasing.\n");
+      p[i] = pdf[1][i] * (a->edges[i+1] - a->edges[i]);
+      sum += p[i];
+   }
+   if(!(sum > 0.0))
+      ismael.error(EXIT_FAILURE, "alias_init: the density is zero.\n");
+
+   /* Vose: p_i scaled to mean 1, the small ones are filled by the large */
+   ns = nl = 0;
+   for(i = 0; i < bins; ++i){
+      p[i] *= (double)bins / sum;
+      if(p[i] < 1.0) small[ns++] = i;
+      else large[nl++] = i;
+   }
+   while((ns > 0) && (nl > 0)){
+      i = small[--ns];
+      j = large[nl-1];
+      a->q[i] = p[i];
+      a->alias[i] = j;
+      p[j] -= 1.0 - p[i];
+      if(p[j] < 1.0){
+         --nl;
+         small[ns++] = j;
+      }
+   }
+   /* The rest is 1 except by rounding */
+   while(nl > 0){
+      i = large[--nl];
+      a->q[i] = 1.0;
+      a->alias[i] = i;
+   }
+   while(ns > 0){
+      i = small[--ns];
+      a->q[i] = 1.0;
+      a->alias[i] = i;
+   }
+
+   /* x = c0 + f c1 if f < q_i, else c2 + f c3, without divisions in the
+      draws */
+   for(i = 0; i < bins; ++i){
+      double *c = a->c + 4 * i, q = a->q[i];
+      j = a->alias[i];
+      c[1] = (q > 0.0) ? (a->edges[i+1] - a->edges[i]) / q : 0.0;
+      c[0] = a->edges[i];
+      c[3] = (q < 1.0) ? (a->edges[j+1] - a->edges[j]) / (1.0 - q) : 0.0;
+      c[2] = a->edges[j] - q * c[3];
+   }
+   free(p);
+   free(small);
+   free(large);
+}
+
+/* The number of the uniform u in [0, 1) */
+static inline double alias_draw(const ismael_alias *a, double u){
+   int i;
+   double v, f;
+   const double *c;
+
+   v = u * (double)a->bins;
+   i = (int)v;
+   if(i >= a->bins) i = a->bins - 1;
+   f = v - (double)i;
+   c = a->c + 4 * i;
+   return (f < a->q[i]) ? c[0] + f * c[1] : c[2] + f * c[3];
+}
+
+double alias_next(const ismael_alias *a, ismael_mt64_state *state){
+   return alias_draw(a, mt19937_64_next(state));
+}
+
+/* The uniforms are written in x by mt64_fill and transformed in place */
+void alias_fill(const ismael_alias *a, ismael_mt64_state *state, double *x,
+size_t n){
+   size_t j;
+
+   mt19937_64_fill(state, x, n);
+   for(j = 0; j < n; ++j) x[j] = alias_draw(a, x[j]);
+}
+
+void alias_free(ismael_alias *a){
+   free(a->edges);
+   free(a->q);
+   free(a->alias);
+   free(a->c);
+   a->edges = a->q = a->c = NULL;
+   a->alias = NULL;
+   a->bins = 0;
+}
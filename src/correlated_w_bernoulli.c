@@ -2,9 +2,16 @@
    Function to compute a set of N correlated numbers using a Bernoulli map
    defined as
 
-   X_i =
+   X_i = X_{i-1} + c \, sign(1/2 - X_{i-1}) \, u_{i-1}^\alpha + b,
+   u_{i-1} = min(X_{i-1}, 1 - X_{i-1})
 
-   Where 
+   Where c = 2^{\alpha-1} (1 - 2b), b = 10^{-12}, X_0 is a pseudo-random
+   number in [0, 1) and \alpha is a parameter that controls correlations.
+
+   The funcion correlated_w_bernoulli_batch iterate M maps in lockstep, each
+   with its own seed and \alpha. The trajectories are the SIMD lanes, the
+   site i of the trajectory m is X[i*M + m] in a array of the caller, and
+   the two branches of the map are blended in one pow without branches.
    *****************************************************************************
    E-mail: ismaellxd@gmail.com
    Site: https://ismaeldamiao.github.io/
@@ -64,5 +71,45 @@ double *correlated_w_bernoulli(double alpha, int N, int seed){
    }
    return X;
 }
+
+uint64_t mt19937_64_genrand(ismael_mt64_state *state); /* MT19937_64.c */
+
+#define LANES 64 /* trajectories per block of the batch */
+void correlated_w_bernoulli_batch(double *X, const double *alpha,
+const int *seed, int M, int N){
+   int i, l, m0, nl;
+   double caux[LANES], x, u, sign, b = 1.0e-12;
+   double *Xi;
+   const double *Xp;
+   ismael_mt64_state state;
+
+   /* The first site of each trajectory is the first number of its seed,
+      with the conversion of the legacy mt64 (the word divided by
+      UINT64_MAX, not mt64_next), then the trajectory m is equal to
+      correlated_w_bernoulli with the seed[m] when it make the first call of
+      mt64. */
+   for(l = 0; l < M; ++l){
+      ismael.random.mt64_init(&state, (uint64_t)seed[l]);
+      X[l] = (double)mt19937_64_genrand(&state) / (double)UINT64_MAX;
+   }
+
+   for(m0 = 0; m0 < M; m0 += LANES){
+      nl = (M - m0 < LANES) ? (M - m0) : LANES;
+      for(l = 0; l < nl; ++l)
+         caux[l] = pow(2.0, alpha[m0+l] - 1.0) * (1.0 - 2.0 * b);
+
+      for(i = 1; i < N; ++i){
+         Xp = X + (size_t)(i-1) * (size_t)M + (size_t)m0;
+         Xi = X + (size_t)i * (size_t)M + (size_t)m0;
+         for(l = 0; l < nl; ++l){
+            x = Xp[l];
+            u = (x < 0.5) ? x : 1.0 - x;
+            sign = (x < 0.5) ? 1.0 : -1.0;
+            Xi[l] = x + caux[l] * sign * pow(u, alpha[m0+l]) + b;
+         }
+      }
+   }
+}
+#undef LANES
 #undef unsigned
 #undef random
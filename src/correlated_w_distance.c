@@ -1,9 +1,14 @@
 /* *****************************************************************************
    Function to compute a set of N correlated numbers using a
 
-   V_i = 
+   V_i = \sum_{j=0}^{N-1} \phi_j (|i-j+1| / \alpha + 1)^{-2}
 
-   Where
+   Where i = 0, ..., N-1 and \phi_j is a set of pseudo-random nunbers in
+   the interval [-1, 1) and \alpha is a parameter that controls correlations.
+
+   The sum is a convolution of \phi with a fixed kernel, then it is computed
+   with the fft of the sequences padded with zeros to size 2^m >= 2N, in
+   O(N log N) operations instead of O(N^2).
    *****************************************************************************
    E-mail: ismaellxd@gmail.com
    Site: https://ismaeldamiao.github.io/
@@ -43,41 +48,54 @@
 
 double *correlated_w_distance(double alpha, int N, int seed){
    unsigned idum;
-   double *V, *phi, aux0, aux1, aux2, deviation;
-   int i, j;
-   double menor = DBL_MAX;
-   double maior = -DBL_MAX;
+   double *V, *phi, aux0, deviation;
+   double _Complex *a, *h;
+   int i, L;
+   double menor, maior;
+   ismael_moments m;
 
    phi = ialloc(N, double);
    V = ialloc(N, double);
 
-   aux1 = aux2 = 0.0;
    idum = seed;
 
    for(i = 0; i < N; ++i) phi[i] = 2.0 * random(&idum) - 1.0;
 
-   for(i = 1; i < N; ++i){
-      V[i] = 0.0;
-      for(j = 0; j < N; ++j){
-         aux0 = (double)abs(i - j + 1) / alpha + 1.0;
-         V[i] += phi[j] / (aux0*aux0);
-      }
-      aux1 += V[i];
-      aux2 += V[i] * V[i];
-      menor = ((menor) < (V[i]) ? (menor) : (V[i]));
-      maior = ((maior) > (V[i]) ? (maior) : (V[i]));
+   /* V_i = \sum_j \phi_j h_{i+1-j}, with h_d = (|d| / \alpha + 1)^{-2} and
+      d = 2-N, ..., N. The negative d are keept in h[L+d], with L >= 2N the
+      circular convolution is equal to the linear one. */
+   for(L = 1; L < 2*N; L <<= 1);
+   a = ialloc(L, double _Complex);
+   h = ialloc(L, double _Complex);
+   for(i = 0; i < L; ++i) a[i] = h[i] = 0.0;
+   for(i = 0; i < N; ++i) a[i] = phi[i];
+   for(i = 0; i <= N; ++i){
+      aux0 = (double)i / alpha + 1.0;
+      h[i] = 1.0 / (aux0*aux0);
+      if((i > 0) && (i < N - 1)) h[L - i] = h[i];
    }
+   fft(a, L, -1);
+   fft(h, L, -1);
+   for(i = 0; i < L; ++i) a[i] *= h[i] / (double)L;
+   fft(a, L, +1);
+
+   for(i = 0; i < N; ++i) V[i] = creal(a[i+1]);
 
    /* Normalize the sequence */
-   aux1 /= ((double)N);
-   aux2 /= ((double)N);
-   deviation = sqrt(aux2 - aux1*aux1);
-   menor = (aux1 - menor) / deviation;
-   maior = (maior - aux1) / deviation + menor;
+   moments_init(&m);
+   moments_add(&m, V, (size_t)N);
+   deviation = sqrt(m.M2 / (double)N);
+   menor = (m.mean - m.min) / deviation;
+   maior = (m.max - m.mean) / deviation + menor;
    menor /= maior;
-   for(i = 0; i < N; ++i) V[i] = menor + (V[i] - aux1) / (deviation * maior);
+   for(i = 0; i < N; ++i)
+      V[i] = menor + (V[i] - m.mean) / (deviation * maior);
 
    free(phi);
+   free(a);
+   free(h);
 
    return V;
 }
+#undef unsigned
+#undef random
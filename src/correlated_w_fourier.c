@@ -7,6 +7,10 @@
 
    Where i = 0, ..., N-1 and \Phi_j is a set of pseudo-random nunbers in
    the interval [0, 2 pi) and \alpha is a parameter that controls correlations.
+
+   The sum is the real part of the inverse discrete Fourier transform of the
+   amplitudes (j+1)^{-0.5\alpha} e^{i \Phi_j}, at the index i+1, then it is
+   computed with the fft in O(N log N) operations instead of O(N^2).
    *****************************************************************************
    E-mail: ismaellxd@gmail.com
    Site: https://ismaeldamiao.github.io/
@@ -56,49 +60,47 @@ double *correlated_w_fourier(double alpha, int N, int seed){
    unsigned int idum;
 #endif
    int N2, i, j;
-   double _2pi, alpha_2, k;
-   double *phi, *V, aux1, aux2, deviation;
-   double menor = DBL_MAX;
-   double maior = -DBL_MAX;
+   double _2pi, alpha_2;
+   double *phi, *V, deviation;
+   double _Complex *c;
+   double menor, maior;
+   ismael_moments m;
 
    _2pi = 2.0 * M_PI;
    alpha_2 = 0.5 * alpha;
-   aux1 = aux2 = 0.0;
    N2 = N / 2;
    idum = seed;
 
    V = (double*)malloc((size_t)((N) * sizeof(double)));
    phi = (double*)malloc((size_t)((N2) * sizeof(double)));
+   c = (double _Complex*)malloc((size_t)((N) * sizeof(double _Complex)));
 
    /* Fist draw the values of phi[i] */
    for(i = 0; i < N2; ++i) phi[i] = _2pi * random(&idum);
 
-   menor = DBL_MAX;
-   maior = -DBL_MAX;
-   for(i = 0; i < N; ++i){
-      /* Compute correlated values */
-      V[i] = 0.0;
-      k = _2pi * (double)(i+1) / ((double)N);
-      for(j = 0; j < N2; ++j)
-      V[i] += cos( k * (j+1) + phi[j]) /
-      pow((double)(j+1), alpha_2);
-
-      aux1 += V[i];
-      aux2 += V[i]*V[i];
-      menor = ((menor) < (V[i]) ? (menor) : (V[i]));
-      maior = ((maior) > (V[i]) ? (maior) : (V[i]));
-   }
+   /* Compute correlated values, V_i = Re(c_{i+1}) where c is the inverse
+      DFT of the amplitudes */
+   for(j = 0; j < N; ++j) c[j] = 0.0;
+   for(j = 0; j < N2; ++j)
+   c[j+1] = CMPLX(cos(phi[j]), sin(phi[j])) / pow((double)(j+1), alpha_2);
+   fft(c, N, +1);
+
+   for(i = 0; i < N; ++i) V[i] = creal(c[(i+1) % N]);
 
    /* Normalize the sequence */
-   aux1 /= ((double)N);
-   aux2 /= ((double)N);
-   deviation = sqrt(aux2 - aux1*aux1);
-   menor = (aux1 - menor) / deviation;
-   maior = (maior - aux1) / deviation + menor;
+   moments_init(&m);
+   moments_add(&m, V, (size_t)N);
+   deviation = sqrt(m.M2 / (double)N);
+   menor = (m.mean - m.min) / deviation;
+   maior = (m.max - m.mean) / deviation + menor;
    menor /= maior;
-   for(i = 0; i < N; ++i) V[i] = menor + (V[i] - aux1) / (deviation * maior);
+   for(i = 0; i < N; ++i)
+      V[i] = menor + (V[i] - m.mean) / (deviation * maior);
 
    free(phi);
+   free(c);
 
    return V;
 }
+#undef unsigned
+#undef random
@@ -0,0 +1,187 @@
+/* *****************************************************************************
+   A C99 implementation of
+
+   *** dSFMT -- double precision SIMD-oriented Fast Mersenne Twister ***
+
+   This generator is a variant of the Mersenne Twister designed for the
+   double precision output, the recursion run over 128 bit words (two lanes
+   of 64 bit) that fit in the SIMD registers and the state words are always
+   IEEE 754 doubles in [1, 2), then no conversion from integer is needed.
+   The period is a multiple of 2^19937 - 1.
+
+   The funcion dsfmt_init initialize a ismael_dsfmt_state with a seed,
+   dsfmt_next return a pseudorandom double uniformly distributed on [0, 1)
+   and dsfmt_fill fill a whole array of such numbers.
+   If __SSE2__ is defined the recursion use the SSE2 instructions.
+
+   References:
+   * M. Saito and M. Matsumoto,
+     "A PRNG Specialized in Double Precision Floating Point Numbers Using
+     an Affine Transition", Monte Carlo and Quasi-Monte Carlo Methods 2008,
+     Springer, 2009, pp 589--602.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include <stdint.h> /* Use C99 or latter */
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Period parameters */
+#define N 191 /* number of 128 bit words, (19937 - 128) / 104 + 1 */
+#define N64 (2*N) /* number of doubles */
+#define POS1 117
+#define SL1 19
+#define SR 12
+#define MSK1 UINT64_C(0x000ffafffffffb3f)
+#define MSK2 UINT64_C(0x000ffdfffc90fffd)
+#define FIX1 UINT64_C(0x90014964b32f4329)
+#define FIX2 UINT64_C(0x3b8d12ac548a7c7a)
+#define PCV1 UINT64_C(0x3d84e1ac0dc82880)
+#define PCV2 UINT64_C(0x0000000000000001)
+#define LOW_MASK UINT64_C(0x000FFFFFFFFFFFFF)
+#define HIGH_CONST UINT64_C(0x3FF0000000000000)
+
+/* The recursion r = f(a, b, lung) for one 128 bit word,
+   lung is the extra word of the state and is updated too. */
+#if defined(__SSE2__)
+#define DO_RECURSION(r, a, b, lung) do{ \
+   __m128i x, y, z, v, w; \
+   x = _mm_loadu_si128((const __m128i*)(a)); \
+   z = _mm_slli_epi64(x, SL1); \
+   y = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(lung)), 0x1b); \
+   z = _mm_xor_si128(z, _mm_loadu_si128((const __m128i*)(b))); \
+   y = _mm_xor_si128(y, z); \
+   v = _mm_srli_epi64(y, SR); \
+   w = _mm_and_si128(y, _mm_set_epi64x((long long)MSK2, (long long)MSK1)); \
+   v = _mm_xor_si128(v, x); \
+   v = _mm_xor_si128(v, w); \
+   _mm_storeu_si128((__m128i*)(r), v); \
+   _mm_storeu_si128((__m128i*)(lung), y); \
+}while(0)
+#else
+#define DO_RECURSION(r, a, b, lung) do{ \
+   uint64_t t0, t1, L0, L1; \
+   t0 = (a)[0]; t1 = (a)[1]; \
+   L0 = (lung)[0]; L1 = (lung)[1]; \
+   (lung)[0] = (t0 << SL1) ^ (L1 >> 32) ^ (L1 << 32) ^ (b)[0]; \
+   (lung)[1] = (t1 << SL1) ^ (L0 >> 32) ^ (L0 << 32) ^ (b)[1]; \
+   (r)[0] = ((lung)[0] >> SR) ^ ((lung)[0] & MSK1) ^ t0; \
+   (r)[1] = ((lung)[1] >> SR) ^ ((lung)[1] & MSK2) ^ t1; \
+}while(0)
+#endif
+
+/* Generate the N words of the state at one time, in place. */
+void dsfmt_generate(ismael_dsfmt_state *state){
+   int i;
+   uint64_t (*s)[2] = state->status;
+   uint64_t lung[2];
+
+   lung[0] = s[N][0];
+   lung[1] = s[N][1];
+   for(i = 0; i < N - POS1; ++i) DO_RECURSION(s[i], s[i], s[i + POS1], lung);
+   for(; i < N; ++i) DO_RECURSION(s[i], s[i], s[i + POS1 - N], lung);
+   s[N][0] = lung[0];
+   s[N][1] = lung[1];
+}
+
+/* Initialize the state vector of one generator with a seed. */
+void dsfmt_init(ismael_dsfmt_state *state, uint32_t seed){
+   int i;
+   uint32_t lo, hi;
+   uint64_t inner, *s = &state->status[0][0];
+
+   /* The words of 32 bit are generated as in the original work (that is
+      little endian) and packed in the 64 bit words. */
+   hi = seed;
+   for(i = 0; i < 2*(N+1); ++i){
+      lo = (i == 0) ? hi :
+      UINT32_C(1812433253) * (hi ^ (hi >> 30)) + (uint32_t)(2*i);
+      hi = UINT32_C(1812433253) * (lo ^ (lo >> 30)) + (uint32_t)(2*i + 1);
+      s[i] = (uint64_t)hi << 32 | lo;
+   }
+   /* Keep only the mantissa of the N state words, then the state is in
+      [1, 2). The lung status[N] is not masked. */
+   for(i = 0; i < 2*N; ++i) s[i] = (s[i] & LOW_MASK) | HIGH_CONST;
+
+   /* Period certification */
+   inner = ((state->status[N][0] ^ FIX1) & PCV1) ^
+   ((state->status[N][1] ^ FIX2) & PCV2);
+   for(i = 32; i > 0; i >>= 1) inner ^= inner >> i;
+   if((inner & 1) == 0) state->status[N][1] ^= UINT64_C(1);
+
+   state->idx = N64; /* the first draw generate N words */
+}
+
+double dsfmt_next(ismael_dsfmt_state *state){
+   union { uint64_t u; double d; } x;
+
+   if(state->idx >= N64){
+      dsfmt_generate(state);
+      state->idx = 0;
+   }
+   x.u = state->status[state->idx / 2][state->idx % 2];
+   ++state->idx;
+
+   return x.d - 1.0; /* from [1, 2) to [0, 1) */
+}
+
+/* Fill x[0], ..., x[n-1] with doubles in [0, 1), in the same order of
+   dsfmt_next. */
+void dsfmt_fill(ismael_dsfmt_state *state, double *x, size_t n){
+   int i, m;
+   const uint64_t *s;
+   union { uint64_t u; double d; } w;
+
+   while(n > 0){
+      if(state->idx >= N64){
+         dsfmt_generate(state);
+         state->idx = 0;
+      }
+      m = N64 - state->idx;
+      if((size_t)m > n) m = (int)n;
+      s = &state->status[0][0] + state->idx;
+      for(i = 0; i < m; ++i){
+         w.u = s[i];
+         x[i] = w.d - 1.0;
+      }
+      state->idx += m;
+      x += m;
+      n -= (size_t)m;
+   }
+}
+#undef N
+#undef N64
+#undef POS1
+#undef SL1
+#undef SR
+#undef MSK1
+#undef MSK2
+#undef FIX1
+#undef FIX2
+#undef PCV1
+#undef PCV2
+#undef LOW_MASK
+#undef HIGH_CONST
+#undef DO_RECURSION
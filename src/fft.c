@@ -0,0 +1,176 @@
+/* *****************************************************************************
+   Function to compute the discrete Fourier transform (DFT)
+
+   X_k = \sum_{j=0}^{N-1} x_j \exp(sign 2 \pi i j k / N)
+
+   of a complex array in place, where k = 0, ..., N-1 and sign = -1 (direct
+   transform) or +1 (inverse transform, not normalized by 1/N).
+   The work is O(N log N) for any N: if N is a power of 2 the iterative
+   radix-2 algorithm is used, else the DFT is written as a convolution
+   (Bluestein algorithm) that is computed with radix-2 transforms of size
+   2^m >= 2N - 1.
+
+   The twiddle factors, the chirp of Bluestein and its work arrays depend
+   only on N, they are computed by fft_plan_init and then fft_plan_exec
+   compute many transforms of size N without allocate memory. The function
+   fft make a plan for one transform. The inverse is computed by the direct
+   one as conj(DFT(conj(x))), then the plan serve for the two signs.
+
+   References:
+   * J. W. Cooley and J. W. Tukey, "An algorithm for the machine calculation
+     of complex Fourier series", Mathematics of Computation, Vol. 19,
+     No. 90, 1965, pp 297--301.
+   * L. I. Bluestein, "A linear filtering approach to the computation of
+     discrete Fourier transform", IEEE Transactions on Audio and
+     Electroacoustics, Vol. 18, No. 4, 1970, pp 451--455.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+/* Radix-2 direct transform of size N (a power of 2) with the twiddles
+   w[k] = exp(-2 pi i k / N), k < N/2. */
+void fft_radix2(double _Complex *x, int N, const double _Complex *w){
+   int i, j, k, len, half, step;
+   double _Complex t, u;
+
+   if(N < 2) return;
+
+   /* Bit reversal permutation */
+   for(i = 1, j = 0; i < N; ++i){
+      k = N >> 1;
+      for(; j & k; k >>= 1) j ^= k;
+      j ^= k;
+      if(i < j){
+         t = x[i];
+         x[i] = x[j];
+         x[j] = t;
+      }
+   }
+
+   for(len = 2; len <= N; len <<= 1){
+      half = len >> 1;
+      step = N / len;
+      for(i = 0; i < N; i += len){
+         for(k = 0; k < half; ++k){
+            u = x[i + k];
+            t = w[k * step] * x[i + k + half];
+            x[i + k] = u + t;
+            x[i + k + half] = u - t;
+         }
+      }
+   }
+}
+
+/* Inverse radix-2 transform by the direct one, conj(DFT(conj(x))) */
+void fft_radix2_inverse(double _Complex *x, int N, const double _Complex *w){
+   int j;
+
+   for(j = 0; j < N; ++j) x[j] = conj(x[j]);
+   fft_radix2(x, N, w);
+   for(j = 0; j < N; ++j) x[j] = conj(x[j]);
+}
+
+void fft_plan_init(ismael_fft_plan *p, int N){
+#if !defined(M_PI)
+   const double M_PI = 3.14159265358979323846;
+#endif
+   int j, M;
+   long long j2;
+
+   p->N = N;
+   p->w = p->c = p->b = p->a = NULL;
+   if(N < 2){
+      p->M = N;
+      return;
+   }
+   if((N & (N - 1)) == 0) M = N;
+   else for(M = 1; M < 2*N - 1; M <<= 1);
+   p->M = M;
+
+   /* The twiddle factors are computed directly, not by recurrence, to keep
+      the precision for large M. */
+   p->w = ialloc(M/2, double _Complex);
+   if(p->w == NULL) ismael.error(EXIT_FAILURE, "fft: out of memory.\n");
+   for(j = 0; j < M/2; ++j)
+      p->w[j] = CMPLX(cos(2.0 * M_PI * j / M), -sin(2.0 * M_PI * j / M));
+   if(M == N) return;
+
+   /* Bluestein: with jk = (j^2 + k^2 - (k-j)^2) / 2 the DFT is
+      X_k = c_k \sum_j (x_j c_j) conj(c_{k-j}), where c_j = exp(-i pi j^2/N),
+      b is the transform of conj(c) padded to M */
+   p->c = ialloc(N, double _Complex);
+   p->b = ialloc(M, double _Complex);
+   p->a = ialloc(M, double _Complex);
+   if((p->c == NULL) || (p->b == NULL) || (p->a == NULL))
+      ismael.error(EXIT_FAILURE, "fft: out of memory.\n");
+   for(j = 0; j < N; ++j){
+      j2 = ((long long)j * j) % (2LL * N); /* exact argument of the chirp */
+      p->c[j] = CMPLX(cos(M_PI * j2 / N), -sin(M_PI * j2 / N));
+   }
+   for(j = 0; j < M; ++j) p->b[j] = 0.0;
+   p->b[0] = conj(p->c[0]);
+   for(j = 1; j < N; ++j) p->b[j] = p->b[M - j] = conj(p->c[j]);
+   fft_radix2(p->b, M, p->w);
+}
+
+/* Transform of x in place with the plan of size N, p->a is the work array
+   of Bluestein */
+void fft_plan_exec(ismael_fft_plan *p, double _Complex *x, int sign){
+   int j;
+   const int N = p->N, M = p->M;
+   double _Complex *a = p->a;
+
+   if(N < 2) return;
+   if(sign > 0) for(j = 0; j < N; ++j) x[j] = conj(x[j]);
+   if(M == N){
+      fft_radix2(x, N, p->w);
+   }else{
+      for(j = 0; j < N; ++j) a[j] = x[j] * p->c[j];
+      for(j = N; j < M; ++j) a[j] = 0.0;
+      fft_radix2(a, M, p->w);
+      for(j = 0; j < M; ++j) a[j] *= p->b[j];
+      fft_radix2_inverse(a, M, p->w);
+      for(j = 0; j < N; ++j) x[j] = p->c[j] * a[j] / (double)M;
+   }
+   if(sign > 0) for(j = 0; j < N; ++j) x[j] = conj(x[j]);
+}
+
+void fft_plan_free(ismael_fft_plan *p){
+   free(p->w);
+   free(p->c);
+   free(p->b);
+   free(p->a);
+   p->w = p->c = p->b = p->a = NULL;
+   p->N = p->M = 0;
+}
+
+void fft(double _Complex *x, int N, int sign){
+   ismael_fft_plan p;
+
+   if(N < 2) return;
+   fft_plan_init(&p, N);
+   fft_plan_exec(&p, x, sign);
+   fft_plan_free(&p);
+}
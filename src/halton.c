@@ -0,0 +1,182 @@
+/* *****************************************************************************
+   Halton low-discrepancy (quasi-random) sequence in d dimensions.
+
+   The coordinate j of the point n is the radical inverse of n in the base
+   p_j (the j-th prime): if n = d_0 + d_1 p + d_2 p^2 + ... then
+   x = d_0/p + d_1/p^2 + ... Each coordinate keep the digits of n and the
+   integer X = x p^K (K digits, p^K <= 2^52), then the next point only add
+   1 to the digits with carry, O(1) in mean, and the point n is computed
+   directly from its digits (halton_seek). The sequence have p^K points
+   in the dimension j (2^52 for p = 2, more than 2^52/p for the others).
+
+   Optionally the digits of the position k of the dimension j are
+   scrambled by a random permutation pi_jk chosen with numbers of mt64,
+   x = pi(d_0)/p + pi(d_1)/p^2 + ... (random digit scrambling). It breaks
+   the correlation of the dimensions of large bases and the points are
+   uniform in [0, 1)^d.
+
+   References:
+   * J. H. Halton, "On the efficiency of certain quasi-random sequences of
+     points in evaluating multi-dimensional integrals", Numerische
+     Mathematik, Vol. 2, 1960, pp 84--90.
+   * A. B. Owen, "Randomly permuted (t,m,s)-nets and (t,s)-sequences",
+     Monte Carlo and Quasi-Monte Carlo Methods in Scientific Computing,
+     Springer, 1995, pp 299--317.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+/* The next point will be the point n */
+void halton_seek(ismael_halton *h, uint64_t n){
+   int j, k, p;
+   uint64_t m, X;
+   const int *pi;
+
+   for(j = 0; j < h->d; ++j){
+      p = h->base[j];
+      m = n;
+      X = 0;
+      for(k = 0; k < h->K[j]; ++k){
+         pi = h->perm + h->off[j] + k * p;
+         h->digit[h->doff[j] + k] = (int)(m % (uint64_t)p);
+         X += (uint64_t)pi[m % (uint64_t)p] * h->w[h->doff[j] + k];
+         m /= (uint64_t)p;
+      }
+      h->X[j] = X;
+   }
+   h->n = n;
+}
+
+/* d dimensions, scrambled with numbers of state if it is not NULL */
+void halton_init(ismael_halton *h, int d, ismael_mt64_state *state){
+   int j, k, i, p, t, nd, np, *pi;
+   uint64_t pk;
+
+   if(d < 1)
+      ismael.error(EXIT_FAILURE, "halton_init: the dimension must be "
+      "positive.\n");
+   h->d = d;
+   h->base = ialloc(d, int);
+   h->K = ialloc(d, int);
+   h->off = ialloc(d, int);
+   h->doff = ialloc(d, int);
+   h->X = ialloc(d, uint64_t);
+   h->scale = ialloc(d, double);
+   if((h->base == NULL) || (h->K == NULL) || (h->off == NULL) ||
+   (h->doff == NULL) || (h->X == NULL) || (h->scale == NULL))
+      ismael.error(EXIT_FAILURE, "halton_init: out of memory.\n");
+
+   /* The first d primes, and K with p^K <= 2^52 */
+   nd = np = 0;
+   for(j = 0, p = 2; j < d; ++p){
+      for(i = 0; (i < j) && (h->base[i] * h->base[i] <= p); ++i)
+         if(p % h->base[i] == 0) break;
+      if((i < j) && (h->base[i] * h->base[i] <= p)) continue;
+      h->base[j] = p;
+      for(k = 0, pk = 1; pk <= (UINT64_C(1) << 52) / (uint64_t)p; ++k)
+         pk *= (uint64_t)p;
+      h->K[j] = k;
+      h->scale[j] = 1.0 / (double)pk;
+      h->doff[j] = nd;
+      h->off[j] = np;
+      nd += k;
+      np += k * p;
+      ++j;
+   }
+   h->digit = ialloc(nd, int);
+   h->w = ialloc(nd, uint64_t);
+   h->perm = ialloc(np, int);
+   if((h->digit == NULL) || (h->w == NULL) || (h->perm == NULL))
+      ismael.error(EXIT_FAILURE, "halton_init: out of memory.\n");
+
+   for(j = 0; j < d; ++j){
+      p = h->base[j];
+      for(k = 0, pk = 1; k < h->K[j]; ++k){
+         /* Weight p^(K-1-k) of the digit k in X */
+         h->w[h->doff[j] + h->K[j] - 1 - k] = pk;
+         pk *= (uint64_t)p;
+         /* Identity, or random permutation by Fisher-Yates */
+         pi = h->perm + h->off[j] + k * p;
+         for(i = 0; i < p; ++i) pi[i] = i;
+         if(state == NULL) continue;
+         for(i = p - 1; i > 0; --i){
+            int r = (int)(mt19937_64_genrand(state) % (uint64_t)(i + 1));
+            t = pi[i]; pi[i] = pi[r]; pi[r] = t;
+         }
+      }
+   }
+   halton_seek(h, 0);
+}
+
+/* The point n in x[0], ..., x[d-1], and go to the point n+1 */
+void halton_next(ismael_halton *h, double *x){
+   int j, k, p, *digit;
+   const int *pi;
+   const uint64_t *w;
+
+   for(j = 0; j < h->d; ++j){
+      x[j] = (double)h->X[j] * h->scale[j];
+      /* n + 1 in the base p, X is changed only in the digits changed */
+      p = h->base[j];
+      digit = h->digit + h->doff[j];
+      w = h->w + h->doff[j];
+      for(k = 0; k < h->K[j]; ++k){
+         pi = h->perm + h->off[j] + k * p;
+         if(digit[k] < p - 1){
+            h->X[j] += (uint64_t)pi[digit[k] + 1] * w[k];
+            h->X[j] -= (uint64_t)pi[digit[k]] * w[k];
+            ++digit[k];
+            break;
+         }
+         h->X[j] += (uint64_t)pi[0] * w[k];
+         h->X[j] -= (uint64_t)pi[p-1] * w[k];
+         digit[k] = 0;
+      }
+   }
+   ++h->n;
+}
+
+/* n points in the rows of the matrix x[i*d + j] */
+void halton_fill(ismael_halton *h, double *x, size_t n){
+   size_t i;
+
+   for(i = 0; i < n; ++i) halton_next(h, x + i * h->d);
+}
+
+void halton_free(ismael_halton *h){
+   free(h->base);
+   free(h->K);
+   free(h->off);
+   free(h->doff);
+   free(h->X);
+   free(h->scale);
+   free(h->digit);
+   free(h->w);
+   free(h->perm);
+   h->base = h->K = h->off = h->doff = h->digit = h->perm = NULL;
+   h->X = h->w = NULL;
+   h->scale = NULL;
+   h->d = 0;
+}
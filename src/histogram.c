@@ -0,0 +1,145 @@
+/* *****************************************************************************
+   Histogram that accumulate a sample chunk by chunk, then the sample never
+   need to be in the memory at one time.
+
+   The bins are fixed at the initialization, uniform in [lo, hi] or given by
+   the caller as bins+1 increasing edges. As in FDP the bin i have the values
+   edges[i] < x <= edges[i+1] (the first one include edges[0]).
+   Histograms with the same bins (e.g. one per thread or per run) can be
+   merged and at end the function histogram_pdf return the density of
+   probability in the same format of FDP.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+void histogram_alloc(ismael_histogram *h, int bins){
+   h->bins = bins;
+   h->edges = ialloc(bins + 1, double);
+   h->count = (long long*)calloc((size_t)bins, sizeof(long long));
+   if((h->edges == NULL) || (h->count == NULL))
+      ismael.error(EXIT_FAILURE, "histogram: out of memory.\n");
+   h->n = h->under = h->over = 0;
+}
+
+/* Uniform bins in [lo, hi] */
+void histogram_init(ismael_histogram *h, double lo, double hi, int bins){
+   int i;
+
+   histogram_alloc(h, bins);
+   h->lo = lo;
+   h->width = (hi - lo) / (double)bins;
+   for(i = 0; i <= bins; ++i) h->edges[i] = lo + i * h->width;
+   h->edges[bins] = hi;
+}
+
+/* Bins given by the caller, edges[0] < edges[1] < ... < edges[bins] */
+void histogram_init_edges(ismael_histogram *h, const double *edges, int bins){
+   int i;
+
+   histogram_alloc(h, bins);
+   for(i = 0; i <= bins; ++i) h->edges[i] = edges[i];
+   h->lo = edges[0];
+   h->width = 0.0; /* not uniform */
+}
+
+void histogram_add(ismael_histogram *h, const double *x, size_t n){
+   size_t j;
+   int i, a, b;
+   double t;
+   const int bins = h->bins;
+   const double *e = h->edges;
+
+   for(j = 0; j < n; ++j){
+      if(x[j] < e[0]){
+         ++h->under;
+         continue;
+      }
+      if(!(x[j] <= e[bins])){ /* out of range or NaN */
+         ++h->over;
+         continue;
+      }
+      if(h->width > 0.0){
+         /* Direct guess, corrected by the edges (rounding) */
+         t = (x[j] - h->lo) / h->width;
+         i = (t < (double)bins) ? (int)t : bins - 1;
+         while((i > 0) && (x[j] <= e[i])) --i;
+         while(x[j] > e[i+1]) ++i;
+      }else{
+         /* Binary search of the first edge >= x */
+         a = 0;
+         b = bins;
+         while(b - a > 1){
+            i = (a + b) / 2;
+            if(x[j] <= e[i]) b = i;
+            else a = i;
+         }
+         i = a;
+      }
+      ++h->count[i];
+   }
+   h->n += (long long)n;
+}
+
+/* h = h + other, the bins need to be the same */
+void histogram_merge(ismael_histogram *h, const ismael_histogram *other){
+   int i;
+
+   if(h->bins != other->bins)
+      ismael.error(EXIT_FAILURE, "histogram_merge: different bins.\n");
+   for(i = 0; i <= h->bins; ++i)
+      if(h->edges[i] != other->edges[i])
+         ismael.error(EXIT_FAILURE, "histogram_merge: different bins.\n");
+
+   for(i = 0; i < h->bins; ++i) h->count[i] += other->count[i];
+   h->n += other->n;
+   h->under += other->under;
+   h->over += other->over;
+}
+
+/* Density of probability, matrix[0][i] is the right edge of the bin i and
+   matrix[1][i] the density, normalized by all the samples added. */
+double **histogram_pdf(const ismael_histogram *h){
+   int i;
+   double **_fdp;
+
+   _fdp = ialloc(2, double*);
+   _fdp[0] = ialloc(h->bins, double);
+   _fdp[1] = ialloc(h->bins, double);
+
+   for(i = 0; i < h->bins; ++i){
+      _fdp[0][i] = h->edges[i+1];
+      _fdp[1][i] = (h->n > 0) ? (double)h->count[i] /
+      ((h->edges[i+1] - h->edges[i]) * (double)h->n) : 0.0;
+   }
+   return _fdp;
+}
+
+void histogram_free(ismael_histogram *h){
+   free(h->edges);
+   free(h->count);
+   h->edges = NULL;
+   h->count = NULL;
+   h->bins = 0;
+}
@@ -0,0 +1,227 @@
+/* *****************************************************************************
+   Kernel Polynomial Method (KPM) for the density of states of a sparse
+   real symmetric Hamiltonian H (e.g. tight binding chains and lattices with
+   the site energies of ismael.random.*) too large to diagonalize.
+
+   The spectrum is mapped in [-1, 1] by H~ = (H - b) / a, with the
+   Gershgorin bounds, and the density is expanded in Chebyshev polynomials
+
+   rho(x) = ( g_0 mu_0 + 2 \sum_{m=1}^{M-1} g_m mu_m T_m(x) ) /
+            ( pi sqrt(1 - x^2) ),   mu_m = (1/n) Tr T_m(H~),
+
+   with the Jackson kernel g_m that damp the Gibbs oscillations. The trace
+   is estimated by R random vectors |r> of components +-1 (from
+   random.mt64), mu_m ~ (1/(R n)) \sum_r <r|T_m(H~)|r>, and the vectors
+   |a_m> = T_m(H~)|r> are given by the recurrence
+   |a_{m+1}> = 2 H~ |a_m> - |a_{m-1}>, with mu_{2m} = 2 <a_m|a_m> - mu_0 and
+   mu_{2m+1} = 2 <a_{m+1}|a_m> - mu_1, then M moments cost M/2 products by
+   H.
+
+   The random vectors are processed in blocks of 8, stored as
+   v[i*8 + r], then each row of H is read one time for the 8 vectors
+   (R is rounded up to a multiple of 8). The products are divided between
+   the threads if compiled with OpenMP.
+
+   The result is in the format of FDP, matrix[0][i] is the energy and
+   matrix[1][i] the density of states (normalized to 1) in the Chebyshev
+   nodes, in ascending order.
+
+   Use:
+   ismael.kpm.lattice(&H, 2, L, eps, true); // or a matrix of the caller
+   dos = ismael.kpm.dos(&H, 1024, 16, 2048, seed);
+   ismael.kpm.free(&H);
+
+   References:
+   * A. Weisse, G. Wellein, A. Alvermann and H. Fehske, "The kernel
+     polynomial method", Reviews of Modern Physics, Vol. 78, 2006,
+     pp 275--306.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+#define KPM_BLOCK 8 /* random vectors processed together */
+
+/* Tight binding hypercubic lattice of dim dimensions with L[d] sites in
+   the direction d, hopping 1 and site energies eps (NULL for 0). The site
+   (x_0, x_1, ...) is i = x_0 + L_0 (x_1 + L_1 (...)). */
+void kpm_lattice(ismael_sparse *H, int dim, const int *L, const double *eps,
+bool periodic){
+   int d, i, n = 1, p = 0, x, stride;
+
+   for(d = 0; d < dim; ++d) n *= L[d];
+   H->n = n;
+   H->ia = ialloc(n + 1, int);
+   H->ja = ialloc((size_t)n * (2 * dim + 1), int);
+   H->va = ialloc((size_t)n * (2 * dim + 1), double);
+   if((H->ia == NULL) || (H->ja == NULL) || (H->va == NULL))
+      ismael.error(EXIT_FAILURE, "kpm_lattice: out of memory.\n");
+
+   for(i = 0; i < n; ++i){
+      H->ia[i] = p;
+      H->ja[p] = i;
+      H->va[p++] = (eps == NULL) ? 0.0 : eps[i];
+      stride = 1;
+      for(d = 0; d < dim; ++d){
+         x = (i / stride) % L[d];
+         if(x > 0){
+            H->ja[p] = i - stride; H->va[p++] = 1.0;
+         }else if(periodic && (L[d] > 2)){
+            H->ja[p] = i + (L[d] - 1) * stride; H->va[p++] = 1.0;
+         }
+         if(x < L[d] - 1){
+            H->ja[p] = i + stride; H->va[p++] = 1.0;
+         }else if(periodic && (L[d] > 2)){
+            H->ja[p] = i - (L[d] - 1) * stride; H->va[p++] = 1.0;
+         }
+         stride *= L[d];
+      }
+   }
+   H->ia[n] = p;
+}
+
+/* w = c H~ v - u (u may be NULL) for the block of vectors, and the sums
+   <v|v> and <w|v> of all the vectors */
+void kpm_step(const ismael_sparse *H, double a, double b, const double *v,
+const double *u, double c, double *w, double *vv, double *wv){
+   int i;
+   const int n = H->n;
+   double svv = 0.0, swv = 0.0;
+
+   ISMAEL_OMP(omp parallel for schedule(static) reduction(+:svv,swv))
+   for(i = 0; i < n; ++i){
+      int p, r;
+      double acc[KPM_BLOCK], x;
+      const double *vi = v + (size_t)i * KPM_BLOCK, *vj;
+
+      for(r = 0; r < KPM_BLOCK; ++r) acc[r] = -b * vi[r];
+      for(p = H->ia[i]; p < H->ia[i+1]; ++p){
+         vj = v + (size_t)H->ja[p] * KPM_BLOCK;
+         for(r = 0; r < KPM_BLOCK; ++r) acc[r] += H->va[p] * vj[r];
+      }
+      for(r = 0; r < KPM_BLOCK; ++r){
+         x = c * acc[r] / a;
+         if(u != NULL) x -= u[(size_t)i * KPM_BLOCK + r];
+         w[(size_t)i * KPM_BLOCK + r] = x;
+         svv += vi[r] * vi[r];
+         swv += x * vi[r];
+      }
+   }
+   *vv = svv;
+   *wv = swv;
+}
+
+/* Density of states of H with M moments, R random vectors (seed of
+   random.mt64) and in points energies */
+double **kpm_dos(const ismael_sparse *H, int M, int R, int points,
+uint64_t seed){
+   int i, m, k, r0;
+   const int n = H->n;
+   size_t j;
+   double lo = DBL_MAX, hi = -DBL_MAX, rad, a, b, s00, s10, vv, wv;
+   double *mu, *v0, *v1, *v2, *tmp, g, x, theta, t, sum, **_dos;
+   ismael_mt64_state rng;
+
+   /* Gershgorin bounds of the spectrum, mapped in [-0.99, 0.99] */
+   for(i = 0; i < n; ++i){
+      rad = 0.0;
+      t = 0.0;
+      for(k = H->ia[i]; k < H->ia[i+1]; ++k){
+         if(H->ja[k] == i) t += H->va[k];
+         else rad += fabs(H->va[k]);
+      }
+      lo = fmin(lo, t - rad);
+      hi = fmax(hi, t + rad);
+   }
+   a = 0.5 * (hi - lo) / 0.99;
+   b = 0.5 * (hi + lo);
+   if(a == 0.0) a = 1.0;
+
+   mu = (double*)calloc((size_t)M + 1, sizeof(double));
+   v0 = ialloc((size_t)n * KPM_BLOCK, double);
+   v1 = ialloc((size_t)n * KPM_BLOCK, double);
+   v2 = ialloc((size_t)n * KPM_BLOCK, double);
+   if((mu == NULL) || (v0 == NULL) || (v1 == NULL) || (v2 == NULL))
+      ismael.error(EXIT_FAILURE, "kpm_dos: out of memory.\n");
+
+   /* Moments, a block of KPM_BLOCK random vectors each time */
+   ismael.random.mt64_init(&rng, seed);
+   for(r0 = 0; r0 < R; r0 += KPM_BLOCK){
+      ismael.random.mt64_fill(&rng, v0, (size_t)n * KPM_BLOCK);
+      for(j = 0; j < (size_t)n * KPM_BLOCK; ++j)
+         v0[j] = (v0[j] < 0.5) ? -1.0 : 1.0;
+
+      /* a_1 = H~ a_0, mu_0 = <a_0|a_0> and mu_1 = <a_1|a_0> */
+      kpm_step(H, a, b, v0, NULL, 1.0, v1, &s00, &s10);
+      mu[0] += s00;
+      mu[1] += s10;
+      for(m = 1; 2 * m < M; ++m){
+         /* a_{m+1} = 2 H~ a_m - a_{m-1} */
+         kpm_step(H, a, b, v1, v0, 2.0, v2, &vv, &wv);
+         mu[2*m] += 2.0 * vv - s00;
+         mu[2*m + 1] += 2.0 * wv - s10;
+         tmp = v0; v0 = v1; v1 = v2; v2 = tmp;
+      }
+   }
+   k = (R + KPM_BLOCK - 1) / KPM_BLOCK * KPM_BLOCK;
+   for(m = 0; m < M; ++m) mu[m] /= (double)k * (double)n;
+
+   /* Jackson kernel */
+   t = M_PI / (double)(M + 1);
+   for(m = 0; m < M; ++m){
+      g = ((M - m + 1) * cos(m * t) + sin(m * t) / tan(t)) / (double)(M + 1);
+      mu[m] *= g;
+   }
+
+   /* Density in the Chebyshev nodes x_k = cos(pi (k + 1/2) / points), in
+      the order of the energies */
+   _dos = ialloc(2, double*);
+   _dos[0] = ialloc(points, double);
+   _dos[1] = ialloc(points, double);
+   for(k = 0; k < points; ++k){
+      theta = M_PI * (k + 0.5) / (double)points;
+      x = cos(theta);
+      sum = mu[0];
+      for(m = 1; m < M; ++m) sum += 2.0 * mu[m] * cos(m * theta);
+      _dos[0][points - 1 - k] = a * x + b;
+      _dos[1][points - 1 - k] = sum / (M_PI * sin(theta) * a);
+   }
+
+   free(mu);
+   free(v0);
+   free(v1);
+   free(v2);
+   return _dos;
+}
+
+void kpm_free(ismael_sparse *H){
+   free(H->ia);
+   free(H->ja);
+   free(H->va);
+   H->ia = H->ja = NULL;
+   H->va = NULL;
+   H->n = 0;
+}
+
+#undef KPM_BLOCK
@@ -0,0 +1,217 @@
+/* *****************************************************************************
+   Moments of a sample in one pass over the memory: count, mean, variance,
+   skewness, kurtosis, minimum and maximum.
+
+   The accumulator keep n, the mean and the central sums
+   M_k = sum (x - mean)^k (k = 2, 3, 4). The values are added block by
+   block of MOMENTS_BLOCK numbers, that are in the cache: the sum, minimum
+   and maximum of the block are computed in LANES independent lanes
+   (vectorized by the compiler), then the central sums about the mean of
+   the block, and the block is merged to the accumulator by the formulas
+   of Chan et al. and Pebay. The sums of the block are about its own mean,
+   then there is not the cancellation of sum x^2 - n mean^2.
+
+   Arrays of more than MOMENTS_CHUNK numbers are divided in chunks of this
+   size, computed in parallel if the library is compiled with OpenMP and
+   merged in order, then the result do not depend of the number of
+   threads. Accumulators of different chunks, threads or runs can be
+   merged by moments_merge.
+
+   References:
+   * T. F. Chan, G. H. Golub and R. J. LeVeque, "Algorithms for Computing
+     the Sample Variance: Analysis and Recommendations", The American
+     Statistician, Vol. 37, 1983, pp 242--247.
+   * P. Pebay, "Formulas for Robust, One-Pass Parallel Computation of
+     Covariances and Arbitrary-Order Statistical Moments", Sandia Report
+     SAND2008-6212, 2008.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+#define LANES 8
+#define MOMENTS_BLOCK 1024
+#define MOMENTS_CHUNK 65536
+
+void moments_init(ismael_moments *m){
+   m->n = 0;
+   m->mean = m->M2 = m->M3 = m->M4 = 0.0;
+   m->min = DBL_MAX;
+   m->max = -DBL_MAX;
+}
+
+/* a = a + b */
+void moments_merge(ismael_moments *a, const ismael_moments *b){
+   double na, nb, n, d, d2, M2, M3, M4;
+
+   if(b->n == 0) return;
+   if(a->n == 0){
+      *a = *b;
+      return;
+   }
+   na = (double)a->n;
+   nb = (double)b->n;
+   n = na + nb;
+   d = b->mean - a->mean;
+   d2 = d * d;
+   M2 = a->M2 + b->M2 + d2 * na * nb / n;
+   M3 = a->M3 + b->M3 + d2 * d * na * nb * (na - nb) / (n * n)
+   + 3.0 * d * (na * b->M2 - nb * a->M2) / n;
+   M4 = a->M4 + b->M4
+   + d2 * d2 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n)
+   + 6.0 * d2 * (na * na * b->M2 + nb * nb * a->M2) / (n * n)
+   + 4.0 * d * (na * b->M3 - nb * a->M3) / n;
+   a->mean += d * nb / n;
+   a->M2 = M2;
+   a->M3 = M3;
+   a->M4 = M4;
+   a->n += b->n;
+   if(b->min < a->min) a->min = b->min;
+   if(b->max > a->max) a->max = b->max;
+}
+
+/* Moments of a block of m <= MOMENTS_BLOCK numbers, in two passes over
+   the cache */
+static void moments_block(ismael_moments *b, const double *x, int m){
+   int i, l, q = m / LANES;
+   double s[LANES], lo[LANES], hi[LANES], s1[LANES], s2[LANES], s3[LANES],
+   s4[LANES], mean, d, d2, t1, t2;
+
+   for(l = 0; l < LANES; ++l){
+      s[l] = s1[l] = s2[l] = s3[l] = s4[l] = 0.0;
+      lo[l] = DBL_MAX;
+      hi[l] = -DBL_MAX;
+   }
+   for(i = 0; i < q; ++i){
+      for(l = 0; l < LANES; ++l){
+         s[l] += x[i*LANES+l];
+         lo[l] = (lo[l] < x[i*LANES+l]) ? lo[l] : x[i*LANES+l];
+         hi[l] = (hi[l] > x[i*LANES+l]) ? hi[l] : x[i*LANES+l];
+      }
+   }
+   for(i = q * LANES; i < m; ++i){
+      s[0] += x[i];
+      lo[0] = (lo[0] < x[i]) ? lo[0] : x[i];
+      hi[0] = (hi[0] > x[i]) ? hi[0] : x[i];
+   }
+   b->n = m;
+   b->min = lo[0];
+   b->max = hi[0];
+   t1 = 0.0;
+   for(l = 0; l < LANES; ++l){
+      t1 += s[l];
+      if(lo[l] < b->min) b->min = lo[l];
+      if(hi[l] > b->max) b->max = hi[l];
+   }
+   mean = t1 / (double)m;
+
+   for(i = 0; i < q; ++i){
+      for(l = 0; l < LANES; ++l){
+         d = x[i*LANES+l] - mean;
+         d2 = d * d;
+         s1[l] += d;
+         s2[l] += d2;
+         s3[l] += d2 * d;
+         s4[l] += d2 * d2;
+      }
+   }
+   for(i = q * LANES; i < m; ++i){
+      d = x[i] - mean;
+      d2 = d * d;
+      s1[0] += d;
+      s2[0] += d2;
+      s3[0] += d2 * d;
+      s4[0] += d2 * d2;
+   }
+   t1 = t2 = b->M3 = b->M4 = 0.0;
+   for(l = 0; l < LANES; ++l){
+      t1 += s1[l];
+      t2 += s2[l];
+      b->M3 += s3[l];
+      b->M4 += s4[l];
+   }
+   /* Correction of the rounding of the mean (the sum of d is 0) */
+   b->mean = mean + t1 / (double)m;
+   b->M2 = t2 - t1 * t1 / (double)m;
+}
+
+/* Add the values of a chunk in order */
+static void moments_chunk(ismael_moments *m, const double *x, size_t n){
+   size_t i;
+   int k;
+   ismael_moments b;
+
+   for(i = 0; i < n; i += MOMENTS_BLOCK){
+      k = (n - i < MOMENTS_BLOCK) ? (int)(n - i) : MOMENTS_BLOCK;
+      moments_block(&b, x + i, k);
+      moments_merge(m, &b);
+   }
+}
+
+/* Add the n values of x to m */
+void moments_add(ismael_moments *m, const double *x, size_t n){
+   long c, nc;
+   ismael_moments *part;
+
+   if(n <= MOMENTS_CHUNK){
+      moments_chunk(m, x, n);
+      return;
+   }
+   nc = (long)((n + MOMENTS_CHUNK - 1) / MOMENTS_CHUNK);
+   /* malloc, the size of the structure is not a power of 2 as
+      aligned_alloc require */
+   part = (ismael_moments*)malloc((size_t)nc * sizeof(ismael_moments));
+   if(part == NULL)
+      ismael.error(EXIT_FAILURE, "moments_add: out of memory.\n");
+   ISMAEL_OMP(omp parallel for schedule(static))
+   for(c = 0; c < nc; ++c){
+      size_t i = (size_t)c * MOMENTS_CHUNK;
+      moments_init(part + c);
+      moments_chunk(part + c, x + i,
+      (n - i < MOMENTS_CHUNK) ? n - i : MOMENTS_CHUNK);
+   }
+   for(c = 0; c < nc; ++c) moments_merge(m, part + c);
+   free(part);
+}
+
+/* Sample variance M2 / (n - 1) */
+double moments_variance(const ismael_moments *m){
+   return (m->n > 1) ? m->M2 / (double)(m->n - 1) : 0.0;
+}
+
+/* sqrt(n) M3 / M2^(3/2) */
+double moments_skewness(const ismael_moments *m){
+   return (m->M2 > 0.0) ?
+   sqrt((double)m->n) * m->M3 / pow(m->M2, 1.5) : 0.0;
+}
+
+/* Excess kurtosis n M4 / M2^2 - 3 */
+double moments_kurtosis(const ismael_moments *m){
+   return (m->M2 > 0.0) ?
+   (double)m->n * m->M4 / (m->M2 * m->M2) - 3.0 : 0.0;
+}
+
+#undef LANES
+#undef MOMENTS_BLOCK
+#undef MOMENTS_CHUNK
@@ -0,0 +1,707 @@
+/* *****************************************************************************
+   Explicit Runge-Kutta integrator for systems of ordinary differential
+   equations dy/dt = f(t, y), with y of n components, driven by the
+   tableaux of the library (ismael.rk8 and ismael.rk14).
+
+   The caller give the function f that write f(t, y) in a array of the
+   integrator (dydt), then in the steps no memory is allocated, all the
+   workspace is allocated in ode_init.
+
+   The tableaux are dense matrices of long double, but most of the
+   coefficients are zero (325 of the 595 of rk14), then in ode_init they are
+   compiled to a list of the nonzero coefficients of each stage in double.
+
+   The step size is controled by a estimate of the local error e: for rk8
+   the step h is compared with two steps h/2 (step doubling, the tableau
+   have no embedded pair), for rk14 e = (h/1000)(k_1 - k_33) [Feagin], and
+   the error norm
+
+   err = sqrt( (1/n) \sum_i ( e_i / (atol + rtol max(|y_i|, |y1_i|)) )^2 )
+
+   is keept <= 1 by h_new = h min(5, max(0.2, 0.9 err^{-1/(p+1)})), where p
+   is the order of the method. For rk8 the accepted solution is the two
+   steps h/2 with the local extrapolation e_i = (y_{h/2,i} - y_{h,i}) /
+   (2^p - 1).
+
+   The step is computed as the increment dy of y, then the solution can be
+   accumulated by compensated sums (ISMAEL_ODE_COMPENSATED, see
+   ode_set_precision): the stages are in double, but y and t are keept as
+   pairs of double with the round off of the sums, then after 10^8 steps
+   the error is that of the method and not the round off of y + dy.
+
+   Use:
+   ismael.ode.init(&ode, ISMAEL_RK8, n, f, params);
+   ismael.ode.set(&ode, t0, y0);
+   ismael.ode.evolve(&ode, t1); // then ode.t == t1 and ode.y is y(t1)
+   ismael.ode.free(&ode);
+
+   References:
+   * G. J. Cooper and J. H. Verner, "Some Explicit Runge-Kutta Methods of
+     High Order", SIAM Journal on Numerical Analysis, Vol. 9, No. 3, 1972,
+     pp 389--405.
+   * E. Hairer, S. P. Norsett and G. Wanner, "Solving Ordinary Differential
+     Equations I", 2nd ed., Springer, 1993, section II.4.
+   * E. Hairer, C. Lubich and G. Wanner, "Geometric Numerical Integration",
+     2nd ed., Springer, 2006, section IV.4.
+   * T. Feagin, "High-order explicit Runge-Kutta methods using
+     m-symmetry", Neural, Parallel & Scientific Computations, Vol. 20, 2012,
+     pp 437--458.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+/* Dense output, in ode_dense.c */
+double *ode_dense_alloc(int n);
+int ode_dense_stages(const ismael_ode *o, const int **stages);
+void ode_dense_mid(ismael_ode *o, const double *ym, const double *fm);
+void ode_dense_save(ismael_ode *o, double h, bool mid);
+
+/* Pointers to the tableau of method in the namespace, return the number of
+   stages s or 0 if the method is unknown. */
+int ode_tableau_long(int method, int *order, const long double **A,
+const long double **B, const long double **C){
+   switch(method){
+      case ISMAEL_RK8:
+         *order = 8;
+         *A = &ismael.rk8.a[0][0]; *B = ismael.rk8.b; *C = ismael.rk8.c;
+         return 11;
+      case ISMAEL_RK14:
+         *order = 14;
+         *A = &ismael.rk14.a[0][0]; *B = ismael.rk14.b; *C = ismael.rk14.c;
+         return 35;
+      default:
+         return 0;
+   }
+}
+
+/* The tableau of rk8 (Cooper and Verner) in long double, from the exact
+   coefficients in terms of sqrt(21); the table of rk8.c has the values
+   rounded to double. */
+void ode_rk8_long(long double a[11][11], long double b[11], long double c[11]){
+   int i, j;
+   const long double r = sqrtl(21.0L);
+
+   for(i = 0; i < 11; ++i){
+      b[i] = 0.0L;
+      for(j = 0; j < 11; ++j) a[i][j] = 0.0L;
+   }
+   a[1][0] = 1.0L / 2.0L;
+   a[2][0] = 1.0L / 4.0L;
+   a[2][1] = 1.0L / 4.0L;
+   a[3][0] = 1.0L / 7.0L;
+   a[3][1] = (-7.0L - 3.0L * r) / 98.0L;
+   a[3][2] = (21.0L + 5.0L * r) / 49.0L;
+   a[4][0] = (11.0L + r) / 84.0L;
+   a[4][2] = (18.0L + 4.0L * r) / 63.0L;
+   a[4][3] = (21.0L - r) / 252.0L;
+   a[5][0] = (5.0L + r) / 48.0L;
+   a[5][2] = (9.0L + r) / 36.0L;
+   a[5][3] = (-231.0L + 14.0L * r) / 360.0L;
+   a[5][4] = (63.0L - 7.0L * r) / 80.0L;
+   a[6][0] = (10.0L - r) / 42.0L;
+   a[6][2] = (-432.0L + 92.0L * r) / 315.0L;
+   a[6][3] = (633.0L - 145.0L * r) / 90.0L;
+   a[6][4] = (-504.0L + 115.0L * r) / 70.0L;
+   a[6][5] = (63.0L - 13.0L * r) / 35.0L;
+   a[7][0] = 1.0L / 14.0L;
+   a[7][4] = (14.0L - 3.0L * r) / 126.0L;
+   a[7][5] = (13.0L - 3.0L * r) / 63.0L;
+   a[7][6] = 1.0L / 9.0L;
+   a[8][0] = 1.0L / 32.0L;
+   a[8][4] = (91.0L - 21.0L * r) / 576.0L;
+   a[8][5] = 11.0L / 72.0L;
+   a[8][6] = (-385.0L - 75.0L * r) / 1152.0L;
+   a[8][7] = (63.0L + 13.0L * r) / 128.0L;
+   a[9][0] = 1.0L / 14.0L;
+   a[9][4] = 1.0L / 9.0L;
+   a[9][5] = (-733.0L - 147.0L * r) / 2205.0L;
+   a[9][6] = (515.0L + 111.0L * r) / 504.0L;
+   a[9][7] = (-51.0L - 11.0L * r) / 56.0L;
+   a[9][8] = (132.0L + 28.0L * r) / 245.0L;
+   a[10][4] = (-42.0L + 7.0L * r) / 18.0L;
+   a[10][5] = (-18.0L + 28.0L * r) / 45.0L;
+   a[10][6] = (-273.0L - 53.0L * r) / 72.0L;
+   a[10][7] = (301.0L + 53.0L * r) / 72.0L;
+   a[10][8] = (28.0L - 28.0L * r) / 45.0L;
+   a[10][9] = (49.0L - 7.0L * r) / 18.0L;
+   b[0] = b[10] = 1.0L / 20.0L;
+   b[7] = b[9] = 49.0L / 180.0L;
+   b[8] = 16.0L / 45.0L;
+   /* c_i = sum_j a_ij */
+   for(i = 0; i < 11; ++i){
+      c[i] = 0.0L;
+      for(j = 0; j < i; ++j) c[i] += a[i][j];
+   }
+}
+
+/* Compile the tableau of method in the list of nonzero coefficients, the
+   row i < s of (ia, ja, va) is the stage i and the row s is the weights b.
+   Return the number of stages s. */
+int ode_tableau(int method, int *order, int **ia, int **ja, double **va,
+double **c){
+   int i, j, s, nnz;
+   const long double *A, *B, *C;
+
+   s = ode_tableau_long(method, order, &A, &B, &C);
+   if(s == 0){
+      ismael.error(EXIT_FAILURE, "ode_tableau: unknown method.\n");
+      return 0;
+   }
+
+   nnz = 0;
+   for(i = 0; i < s; ++i){
+      for(j = 0; j < i; ++j) if(A[i*s + j] != 0.0L) ++nnz;
+      if(B[i] != 0.0L) ++nnz;
+   }
+   *ia = ialloc(s + 2, int);
+   *ja = ialloc(nnz, int);
+   *va = ialloc(nnz, double);
+   *c = ialloc(s, double);
+   if((*ia == NULL) || (*ja == NULL) || (*va == NULL) || (*c == NULL))
+      ismael.error(EXIT_FAILURE, "ode_tableau: out of memory.\n");
+   nnz = 0;
+   for(i = 0; i <= s; ++i){
+      (*ia)[i] = nnz;
+      for(j = 0; j < ((i < s) ? i : s); ++j){
+         if(((i < s) ? A[i*s + j] : B[j]) == 0.0L) continue;
+         (*ja)[nnz] = j;
+         (*va)[nnz] = (double)((i < s) ? A[i*s + j] : B[j]);
+         ++nnz;
+      }
+   }
+   (*ia)[s+1] = nnz;
+   for(i = 0; i < s; ++i) (*c)[i] = (double)C[i];
+   return s;
+}
+
+/* Default control of the step and options of o. The workspace is keept,
+   then an integrator can be reused for other problem (see ode_sweep). */
+void ode_defaults(ismael_ode *o){
+   o->adaptive = true;
+   o->rtol = 1.0e-10;
+   o->atol = 1.0e-12;
+   o->h = 1.0e-3;
+   o->hlast = 0.0;
+   o->hmin = 0.0;
+   o->hmax = HUGE_VAL;
+   o->nsteps = o->nrejected = o->nfev = 0;
+   o->precision = ISMAEL_ODE_DOUBLE;
+   o->fl = NULL;
+   o->dense = false;
+   o->nd = 0;
+   o->conserve = false;
+   o->norm = 0.0;
+}
+
+void ode_init(ismael_ode *o, int method, int n, ismael_ode_rhs f,
+void *params){
+   int i, s;
+
+   /* The tableau is compiled in double precision and only the nonzero
+      coefficients are keept */
+   s = ode_tableau(method, &o->order, &o->ia, &o->ja, &o->va, &o->c);
+
+   o->method = method;
+   o->n = n;
+   o->s = s;
+   o->f = f;
+   o->params = params;
+   ode_defaults(o);
+
+   /* Workspace, the long double one is allocated by ode_set_precision */
+   o->yl = o->wl = NULL;
+   o->nc = 0;
+   o->td = o->hd = 0.0;
+   o->t = o->tc = 0.0;
+   o->tl = 0.0L;
+   o->y = ialloc(n, double);
+   o->yc = ialloc(n, double);
+   o->k = ialloc(s * n, double);
+   o->f0 = ialloc(n, double);
+   o->ytmp = ialloc(n, double);
+   o->y1 = ialloc(n, double);
+   o->y2 = ialloc(n, double);
+   o->yd = ode_dense_alloc(n);
+   if((o->y == NULL) || (o->yc == NULL) || (o->k == NULL) ||
+   (o->f0 == NULL) || (o->ytmp == NULL) || (o->y1 == NULL) ||
+   (o->y2 == NULL) || (o->yd == NULL))
+      ismael.error(EXIT_FAILURE, "ode_init: out of memory.\n");
+   for(i = 0; i < n; ++i) o->y[i] = o->yc[i] = 0.0;
+}
+
+/* The round off of the sums y + dy (n numbers) and t + h of the steps in
+   long double, after the workspace of ode_step_long */
+long double *ode_compensation_long(ismael_ode *o){
+   return o->wl + o->ia[o->s+1] + o->s + (o->s + 4) * o->n;
+}
+
+void ode_set(ismael_ode *o, double t, const double *y){
+   int i;
+
+   o->t = t;
+   o->tc = 0.0;
+   o->nd = 0;
+   o->norm = 0.0;
+   for(i = 0; i < o->n; ++i){
+      o->y[i] = y[i];
+      o->yc[i] = 0.0;
+      o->norm += y[i] * y[i];
+   }
+   if(o->yl == NULL) return;
+   o->tl = t;
+   for(i = 0; i < o->n; ++i) o->yl[i] = y[i];
+   for(i = 0; i <= o->n; ++i) ode_compensation_long(o)[i] = 0.0L;
+}
+
+/* Precision of the arithmetic of the steps:
+   ISMAEL_ODE_DOUBLE, the default, all in double;
+   ISMAEL_ODE_COMPENSATED, the stages in double but y and t are accumulated
+   by compensated sums, then the round off of y + dy do not grow with the
+   number of steps;
+   ISMAEL_ODE_LONG_DOUBLE, all in long double (slow) and y and t are
+   accumulated by compensated sums of long double too. For rk8 the
+   coefficients are computed in long double from the exact ones
+   (ode_rk8_long), then the mode is a reference to validate the other ones.
+   The coefficients of rk14 are known only as decimal numbers and the table
+   has them rounded to double, then for rk14 only the arithmetic is in long
+   double and the error of the tableau (about 1e-17 h per step) remains.
+   The function f is o->fl if given by the caller, else o->f with the
+   arguments rounded to double.
+   The current solution (o->t, o->y) is keept. */
+void ode_set_precision(ismael_ode *o, int precision){
+   int i, p, s = o->s, n = o->n, order;
+   const long double *A = NULL, *B = NULL, *C = NULL;
+   long double *val, *cl, a8[11][11], b8[11], c8[11];
+
+   o->precision = precision;
+   o->tc = 0.0;
+   o->nd = 0;
+   for(i = 0; i < n; ++i) o->yc[i] = 0.0;
+   if((precision != ISMAEL_ODE_LONG_DOUBLE) || (o->wl != NULL)){
+      if(o->yl == NULL) return;
+      o->tl = o->t;
+      for(i = 0; i < n; ++i) o->yl[i] = o->y[i];
+      for(i = 0; i <= n; ++i) ode_compensation_long(o)[i] = 0.0L;
+      return;
+   }
+
+   /* Workspace of long double, the coefficients va and c, k[s*n], f0, ytmp,
+      y1, y2 and the compensation of the sums y + dy and t + h */
+   o->yl = ialloc(n, long double);
+   o->wl = ialloc(o->ia[s+1] + s + (s + 5) * n + 1, long double);
+   if((o->yl == NULL) || (o->wl == NULL))
+      ismael.error(EXIT_FAILURE, "ode_set_precision: out of memory.\n");
+   val = o->wl;
+   cl = val + o->ia[s+1];
+   if(o->method == ISMAEL_RK8){
+      ode_rk8_long(a8, b8, c8);
+      A = &a8[0][0]; B = b8; C = c8;
+   }else if(ode_tableau_long(o->method, &order, &A, &B, &C) != s){
+      ismael.error(EXIT_FAILURE, "ode_set_precision: unknown method.\n");
+      return;
+   }
+   for(i = 0; i <= s; ++i)
+      for(p = o->ia[i]; p < o->ia[i+1]; ++p)
+         val[p] = (i < s) ? A[i*s + o->ja[p]] : B[o->ja[p]];
+   for(i = 0; i < s; ++i) cl[i] = C[i];
+   o->tl = o->t;
+   for(i = 0; i < n; ++i) o->yl[i] = o->y[i];
+   for(i = 0; i <= n; ++i) ode_compensation_long(o)[i] = 0.0L;
+}
+
+/* One step of size h from (t, y), the increment of y is writen in dy and
+   f0 = f(t, y) is given. dy can be o->ytmp but not y. */
+void ode_rk(ismael_ode *o, double t, const double *y, double h,
+const double *f0, double *dy){
+   int i, p, m;
+   const int n = o->n, s = o->s;
+   const int *ia = o->ia, *ja = o->ja;
+   const double *va = o->va;
+   double *k = o->k, *ytmp, ha, *kj;
+
+   for(m = 0; m < n; ++m) k[m] = f0[m];
+   for(i = 1; i <= s; ++i){
+      ytmp = (i < s) ? o->ytmp : dy;
+      for(m = 0; m < n; ++m) ytmp[m] = (i < s) ? y[m] : 0.0;
+      for(p = ia[i]; p < ia[i+1]; ++p){
+         ha = h * va[p];
+         kj = k + ja[p]*n;
+         for(m = 0; m < n; ++m) ytmp[m] += ha * kj[m];
+      }
+      if(i < s) o->f(t + o->c[i] * h, ytmp, k + i*n, o->params);
+   }
+   o->nfev += s - 1;
+}
+
+/* Error norm of e scaled by the tolerances, dy is the increment of y */
+double ode_error_norm(const ismael_ode *o, const double *y, const double *e,
+const double *dy){
+   int m;
+   double sc, r, sum = 0.0;
+
+   for(m = 0; m < o->n; ++m){
+      sc = o->atol + o->rtol * fmax(fabs(y[m]), fabs(y[m] + dy[m]));
+      r = e[m] / sc;
+      sum += r * r;
+   }
+   return sqrt(sum / (double)o->n);
+}
+
+/* New step size from the error norm */
+double ode_new_step(int order, double hmax, double h, double err){
+   double fac;
+
+   fac = (err > 0.0) ? 0.9 * pow(err, -1.0 / (double)(order + 1)) : 5.0;
+   fac = fmin(5.0, fmax(0.2, fac));
+   h *= fac;
+   if(fabs(h) > hmax) h = copysign(hmax, h);
+   return h;
+}
+
+/* Attempt of a step h from (o->t, o->y), o->f0 = f(t, y), the increment of
+   the solution is in y1 and the estimate of the local error in y2. */
+void ode_attempt(ismael_ode *o, double h){
+   int m;
+   const int n = o->n;
+
+   if(o->method == ISMAEL_RK14){
+      /* Error estimate of Feagin, (h/1000) (k_1 - k_33) */
+      ode_rk(o, o->t, o->y, h, o->f0, o->y1);
+      for(m = 0; m < n; ++m)
+         o->y2[m] = 1.0e-3 * h * (o->k[n + m] - o->k[33*n + m]);
+      return;
+   }
+
+   /* Two steps h/2 in y1 and one step h in y2 */
+   ode_rk(o, o->t, o->y, 0.5 * h, o->f0, o->y1);
+   for(m = 0; m < n; ++m) o->y2[m] = o->y[m] + o->y1[m];
+   o->f(o->t + 0.5 * h, o->y2, o->k, o->params);
+   ++o->nfev;
+   if(o->dense) ode_dense_mid(o, o->y2, o->k);
+   ode_rk(o, o->t + 0.5 * h, o->y2, 0.5 * h, o->k, o->ytmp);
+   for(m = 0; m < n; ++m) o->y1[m] += o->ytmp[m];
+   ode_rk(o, o->t, o->y, h, o->f0, o->y2);
+
+   /* Local extrapolation of y1 with the error in y2 */
+   for(m = 0; m < n; ++m){
+      o->y2[m] = (o->y1[m] - o->y2[m]) / (double)((1 << o->order) - 1);
+      o->y1[m] += o->y2[m];
+   }
+}
+
+/* y += dy. In the mode ISMAEL_ODE_COMPENSATED the sum is the TwoSum of
+   Knuth, y + yc is exactly the sum of the increments (no branches, then the
+   loop is vectorized). */
+void ode_add(ismael_ode *o, const double *dy){
+   int m;
+   const int n = o->n;
+   double *y = o->y, *yc = o->yc, a, b, sum, bb;
+
+   if(o->precision != ISMAEL_ODE_COMPENSATED){
+      for(m = 0; m < n; ++m) y[m] += dy[m];
+      return;
+   }
+
+   for(m = 0; m < n; ++m){
+      a = y[m];
+      b = dy[m] + yc[m];
+      sum = a + b;
+      bb = sum - a;
+      yc[m] = (a - (sum - bb)) + (b - bb);
+      y[m] = sum;
+   }
+}
+
+/* Accept the step h, y += y1 and t += h */
+void ode_advance(ismael_ode *o, double h){
+   double a, b, sum, bb;
+
+   ode_add(o, o->y1);
+   if(o->precision != ISMAEL_ODE_COMPENSATED){
+      o->t += h;
+      return;
+   }
+   a = o->t;
+   b = h + o->tc;
+   sum = a + b;
+   bb = sum - a;
+   o->tc = (a - (sum - bb)) + (b - bb);
+   o->t = sum;
+}
+
+/* If o->conserve, project y in the sphere |y|^2 = o->norm (the value of
+   ode_set), for quadratic invariants as the norm of a wave function
+   [Hairer, Lubich and Wanner]. */
+void ode_project(ismael_ode *o){
+   int m;
+   const int n = o->n;
+   double sum = 0.0, fac;
+   long double suml = 0.0L, facl;
+
+   if(!o->conserve || (o->norm <= 0.0)) return;
+
+   if(o->precision == ISMAEL_ODE_LONG_DOUBLE){
+      for(m = 0; m < n; ++m) suml += o->yl[m] * o->yl[m];
+      facl = sqrtl(o->norm / suml);
+      for(m = 0; m < n; ++m){
+         o->yl[m] *= facl;
+         o->y[m] = (double)o->yl[m];
+      }
+      return;
+   }
+
+   /* y += (fac - 1) y, then the compensation is keept */
+   for(m = 0; m < n; ++m) sum += o->y[m] * o->y[m];
+   fac = sqrt(o->norm / sum) - 1.0;
+   for(m = 0; m < n; ++m) o->ytmp[m] = fac * o->y[m];
+   ode_add(o, o->ytmp);
+}
+
+/* The mode ISMAEL_ODE_LONG_DOUBLE, the same algorithm of ode_rk,
+   ode_attempt and ode_step in long double. */
+void ode_fl(ismael_ode *o, long double t, const long double *y,
+long double *dydt){
+   int m;
+
+   if(o->fl != NULL){
+      o->fl(t, y, dydt, o->params);
+      return;
+   }
+   for(m = 0; m < o->n; ++m) o->ytmp[m] = (double)y[m];
+   o->f((double)t, o->ytmp, o->f0, o->params);
+   for(m = 0; m < o->n; ++m) dydt[m] = o->f0[m];
+}
+
+void ode_rkl(ismael_ode *o, long double t, const long double *y,
+long double h, const long double *f0, long double *dy){
+   int i, p, m;
+   const int n = o->n, s = o->s;
+   const int *ia = o->ia, *ja = o->ja;
+   const long double *val = o->wl, *cl = val + ia[s+1];
+   long double *k = (long double*)cl + s, *ytmp, ha, *kj;
+
+   for(m = 0; m < n; ++m) k[m] = f0[m];
+   for(i = 1; i <= s; ++i){
+      ytmp = (i < s) ? k + (s + 1)*n : dy;
+      for(m = 0; m < n; ++m) ytmp[m] = (i < s) ? y[m] : 0.0L;
+      for(p = ia[i]; p < ia[i+1]; ++p){
+         ha = h * val[p];
+         kj = k + ja[p]*n;
+         for(m = 0; m < n; ++m) ytmp[m] += ha * kj[m];
+      }
+      if(i < s) ode_fl(o, t + cl[i] * h, ytmp, k + i*n);
+   }
+   o->nfev += s - 1;
+}
+
+int ode_step_long(ismael_ode *o){
+   int m;
+   const int n = o->n, s = o->s;
+   long double *k = o->wl + o->ia[s+1] + s, *f0 = k + s*n;
+   long double *ytmp = f0 + n, *y1 = ytmp + n, *y2 = y1 + n, *y = o->yl;
+   long double *yc = ode_compensation_long(o);
+   long double h = o->h, sc, r, sum;
+   double err;
+
+   ode_fl(o, o->tl, y, f0);
+   ++o->nfev;
+
+   for(;;){
+      if(!o->adaptive){
+         ode_rkl(o, o->tl, y, h, f0, y1);
+      }else if(o->method == ISMAEL_RK14){
+         ode_rkl(o, o->tl, y, h, f0, y1);
+         for(m = 0; m < n; ++m)
+            y2[m] = 1.0e-3L * h * (k[n + m] - k[33*n + m]);
+      }else{
+         ode_rkl(o, o->tl, y, 0.5L * h, f0, y1);
+         for(m = 0; m < n; ++m) y2[m] = y[m] + y1[m];
+         ode_fl(o, o->tl + 0.5L * h, y2, k);
+         ++o->nfev;
+         if(o->dense){
+            for(m = 0; m < n; ++m){
+               o->ytmp[m] = (double)y2[m];
+               o->y2[m] = (double)k[m];
+            }
+            ode_dense_mid(o, o->ytmp, o->y2);
+         }
+         ode_rkl(o, o->tl + 0.5L * h, y2, 0.5L * h, k, ytmp);
+         for(m = 0; m < n; ++m) y1[m] += ytmp[m];
+         ode_rkl(o, o->tl, y, h, f0, y2);
+         for(m = 0; m < n; ++m){
+            y2[m] = (y1[m] - y2[m]) / (long double)((1 << o->order) - 1);
+            y1[m] += y2[m];
+         }
+      }
+
+      err = 0.0;
+      if(o->adaptive){
+         sum = 0.0L;
+         for(m = 0; m < n; ++m){
+            sc = o->atol + o->rtol * fmaxl(fabsl(y[m]), fabsl(y[m] + y1[m]));
+            r = y2[m] / sc;
+            sum += r * r;
+         }
+         err = (double)sqrtl(sum / (long double)n);
+      }
+
+      if(err <= 1.0){
+         if(o->dense){
+            /* The step in the workspace of double, as in ode_step */
+            const int *st;
+            int j, ns = ode_dense_stages(o, &st);
+            for(m = 0; m < n; ++m){
+               o->f0[m] = (double)f0[m];
+               o->y1[m] = (double)y1[m];
+            }
+            for(j = 0; j < ns; ++j)
+               for(m = 0; m < n; ++m)
+                  o->k[st[j]*n + m] = (double)k[st[j]*n + m];
+            ode_dense_save(o, (double)h,
+            o->adaptive && (o->method == ISMAEL_RK8));
+         }
+         /* y += y1 and t += h by compensated sums, as in ode_add */
+         for(m = 0; m <= n; ++m){
+            long double *a = (m < n) ? y + m : &o->tl, b, ss, bb;
+            b = ((m < n) ? y1[m] : h) + yc[m];
+            ss = *a + b;
+            bb = ss - *a;
+            yc[m] = (*a - (ss - bb)) + (b - bb);
+            *a = ss;
+         }
+         for(m = 0; m < n; ++m) o->y[m] = (double)y[m];
+         o->t = (double)o->tl;
+         ode_project(o);
+         o->hlast = (double)h;
+         if(o->adaptive) o->h = ode_new_step(o->order, o->hmax, h, err);
+         ++o->nsteps;
+         return 0;
+      }
+
+      ++o->nrejected;
+      h = ode_new_step(o->order, o->hmax, h, err);
+      if((fabsl(h) < o->hmin) || (fabsl(h) <= 4.0 * DBL_EPSILON * fabs(o->t))){
+         o->h = h;
+         return -1;
+      }
+   }
+}
+
+/* Take one step from (o->t, o->y), if adaptive the step is repeated with
+   smaller h until the error is accepted. Return 0 or -1 if the step size is
+   smaller than hmin. */
+int ode_step(ismael_ode *o){
+   double h = o->h, err;
+
+   if(o->precision == ISMAEL_ODE_LONG_DOUBLE) return ode_step_long(o);
+
+   o->f(o->t, o->y, o->f0, o->params);
+   ++o->nfev;
+
+   if(!o->adaptive){
+      ode_rk(o, o->t, o->y, h, o->f0, o->y1);
+      ode_dense_save(o, h, false);
+      ode_advance(o, h);
+      ode_project(o);
+      o->hlast = h;
+      ++o->nsteps;
+      return 0;
+   }
+
+   for(;;){
+      ode_attempt(o, h);
+      err = ode_error_norm(o, o->y, o->y2, o->y1);
+
+      if(err <= 1.0){
+         ode_dense_save(o, h, o->method == ISMAEL_RK8);
+         ode_advance(o, h);
+         ode_project(o);
+         o->hlast = h;
+         o->h = ode_new_step(o->order, o->hmax, h, err);
+         ++o->nsteps;
+         return 0;
+      }
+
+      ++o->nrejected;
+      h = ode_new_step(o->order, o->hmax, h, err);
+      if((fabs(h) < o->hmin) || (fabs(h) <= 4.0 * DBL_EPSILON * fabs(o->t))){
+         o->h = h;
+         return -1;
+      }
+   }
+}
+
+/* One step from o->t in the direction of t1, cut to stop at t1. */
+int ode_step_until(ismael_ode *o, double t1){
+   bool cut;
+   double dir, hcut, hsave;
+
+   if((t1 - o->t) * o->h < 0.0) o->h = -o->h;
+   dir = (o->h > 0.0) ? 1.0 : -1.0;
+   hsave = o->h;
+   if(o->precision == ISMAEL_ODE_LONG_DOUBLE)
+      hcut = (double)((long double)t1 - o->tl);
+   else
+      hcut = (t1 - o->t) - o->tc;
+   cut = (hcut * dir <= hsave * dir);
+   if(cut) o->h = hcut;
+   if(ode_step(o) != 0) return -1;
+   if(cut && (o->hlast == hcut)){
+      o->t = t1; /* remove the round off */
+      o->tc = 0.0;
+      o->tl = t1;
+      o->h = hsave;
+   }
+   return 0;
+}
+
+/* Integrate from o->t to t1, the last step is cut to stop at t1. */
+int ode_evolve(ismael_ode *o, double t1){
+   double dir;
+
+   dir = (t1 > o->t) ? 1.0 : -1.0;
+   while((t1 - o->t) * dir > 0.0)
+      if(ode_step_until(o, t1) != 0) return -1;
+   return 0;
+}
+
+void ode_free(ismael_ode *o){
+   free(o->y);
+   free(o->yc);
+   free(o->yl);
+   free(o->wl);
+   free(o->ia);
+   free(o->ja);
+   free(o->va);
+   free(o->c);
+   free(o->k);
+   free(o->f0);
+   free(o->ytmp);
+   free(o->y1);
+   free(o->y2);
+   free(o->yd);
+   o->y = NULL;
+   o->yl = o->wl = NULL;
+}
@@ -0,0 +1,113 @@
+/* *****************************************************************************
+   Complex systems dpsi/dt = f(t, psi), with psi of n complex components,
+   integrated by the Runge-Kutta methods of ode.c as a real system of 2n
+   components in split layout: y[r] = Re psi_r and y[n + r] = Im psi_r.
+   Then the stages are loops over contiguous double that the compiler
+   vectorize, as in the real case, and the function f of the caller
+   receive and write the two halves.
+
+   For the Schrodinger equation i dpsi/dt = H psi (hbar = 1) with H real
+   symmetric
+
+   d Re psi / dt = H Im psi,   d Im psi / dt = - H Re psi,
+
+   ode_hamiltonian is f for a band matrix H (e.g. the tight binding chain
+   with H[i][i] the site energies and H[i][i+1] the hopping), one loop per
+   diagonal and no function call per site.
+
+   The norm |psi|^2 is not conserved by the explicit Runge-Kutta methods,
+   the error grow with the time, then ode_init_complex set ode->conserve
+   and after each step psi is projected to the norm of ode_set_complex.
+
+   Use:
+   ismael.ode.init_complex(&ode, ISMAEL_RK8, n, ismael.ode.hamiltonian, &H);
+   ismael.ode.set_complex(&ode, t0, psi0);
+   ismael.ode.evolve(&ode, t1);
+   ismael.ode.get_complex(&ode, psi);
+   ismael.ode.free(&ode);
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+void ode_init_complex(ismael_ode *o, int method, int n, ismael_ode_rhs f,
+void *params){
+   ode_init(o, method, 2 * n, f, params);
+   o->nc = n;
+   o->conserve = true;
+}
+
+void ode_set_complex(ismael_ode *o, double t, const _Complex double *psi){
+   int r;
+   const int n = o->nc;
+
+   for(r = 0; r < n; ++r){
+      o->ytmp[r] = creal(psi[r]);
+      o->ytmp[n + r] = cimag(psi[r]);
+   }
+   ode_set(o, t, o->ytmp);
+}
+
+void ode_get_complex(const ismael_ode *o, _Complex double *psi){
+   int r;
+   const int n = o->nc;
+
+   for(r = 0; r < n; ++r) psi[r] = CMPLX(o->y[r], o->y[n + r]);
+}
+
+/* f(t, psi) = -i H psi for H of type ismael_band_hamiltonian in params */
+void ode_hamiltonian(double t, const double *y, double *dydt, void *params){
+   int i, k;
+   const ismael_band_hamiltonian *H = params;
+   const int n = H->n;
+   const double *re = y, *im = y + n, *d;
+   double *dre = dydt, *dim = dydt + n;
+   (void)t;
+
+   d = H->d[0];
+   for(i = 0; i < n; ++i){
+      dre[i] = d[i] * im[i];
+      dim[i] = -d[i] * re[i];
+   }
+   for(k = 1; k <= H->bands; ++k){
+      d = H->d[k];
+      /* H[i][i+k] and H[i+k][i] in two loops, then no dependence between
+         the iterations */
+      for(i = 0; i < n - k; ++i){
+         dre[i] += d[i] * im[i + k];
+         dim[i] -= d[i] * re[i + k];
+      }
+      for(i = 0; i < n - k; ++i){
+         dre[i + k] += d[i] * im[i];
+         dim[i + k] -= d[i] * re[i];
+      }
+      if(!H->periodic) continue;
+      for(i = n - k; i < n; ++i){
+         dre[i] += d[i] * im[i + k - n];
+         dim[i] -= d[i] * re[i + k - n];
+         dre[i + k - n] += d[i] * im[i];
+         dim[i + k - n] -= d[i] * re[i];
+      }
+   }
+}
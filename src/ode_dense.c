@@ -0,0 +1,349 @@
+/* *****************************************************************************
+   Dense output of the Runge-Kutta integrator of ode.c, the solution in any
+   time of the last step, and location of events g(t, y) = 0.
+
+   If ode->dense is true each step keep y0 = y(t0), f0 = f(t0, y0), the
+   increment dy = y1 - y0 and the derivatives of the stages of order 5
+   (rk8, c = 0.17, 0.5, 0.83 and 1) or 8 (rk14, the stages 17 to 22 and
+   34), for rk8 adaptive also the midpoint ym of the step doubling and
+   fm = f(t0 + h/2, ym), and the step before if this one start at its end. The solution in t0 + theta h is the polynomial
+
+   p(theta) = y0 + \sum_{m=1}^{q} alpha_m theta^m
+
+   of the q conditions of value and derivative (h f) in the nodes theta,
+   solved in the first interpolation of the step. No evaluation of f is
+   need. The nodes of the stages with 0 and 1 are a Lobatto quadrature
+   that give y1, then the stage c = 1 is not used with the value in 1.
+   For rk8 with the midpoint and the step before q = 8, the error is
+   O(h^9), of the order of the tolerance of the steps. For rk14 (or rk8
+   with fixed steps) the stages limit the error to O(h^10) (O(h^6)), less
+   accurate than the steps at tight tolerances.
+
+   The event is the change of sign of g(t, y, params) between the ends of
+   a step, then the root is located in the interpolant by the Illinois
+   method (regula falsi that halve the function value of the end that do
+   not move) and the integrator stop there.
+
+   Use:
+   ode.dense = true;
+   ismael.ode.step(&ode);
+   ismael.ode.interpolate(&ode, t, y); // ode.t - ode.hlast <= t <= ode.t
+
+   References:
+   * E. Hairer, S. P. Norsett and G. Wanner, "Solving Ordinary Differential
+     Equations I", 2nd ed., Springer, 1993, sections II.6 and III.1.
+   * M. Dowell and P. Jarratt, "A modified regula falsi method for computing
+     the root of an equation", BIT, Vol. 11, 1971, pp 168--174.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+/* Slots of n numbers in o->yd: the step (y0, f0, the midpoint ym and fm
+   of rk8, dy = y1 - y0), the midpoint of the attempt in progress, the step
+   before (yp, fp, ypm, fpm), the stages of ode_dense_stages and the
+   coefficients of the interpolant. */
+#define Y0 0
+#define F0 1
+#define YM 2
+#define FM 3
+#define DY 4
+#define YM_NEW 5
+#define FM_NEW 6
+#define YP 7
+#define FP 8
+#define YPM 9
+#define FPM 10
+#define STAGE 11
+#define ALPHA 18
+#define MAXQ 11 /* conditions of the interpolant */
+
+/* Stages of order 5 (rk8) and 8 (rk14) in the interior of the step */
+static const int ode_dense_rk8[4] = {7, 8, 9, 10};
+static const int ode_dense_rk14[7] = {17, 18, 19, 20, 21, 22, 34};
+
+double *ode_dense_alloc(int n){
+   return ialloc((ALPHA + MAXQ) * n, double);
+}
+
+/* The stages keept by ode_dense_save, k + stages[j]*n */
+int ode_dense_stages(const ismael_ode *o, const int **stages){
+   if(o->method == ISMAEL_RK14){
+      *stages = ode_dense_rk14;
+      return 7;
+   }
+   *stages = ode_dense_rk8;
+   return 4;
+}
+
+/* Midpoint of the step doubling of rk8, keept if the step is accepted */
+void ode_dense_mid(ismael_ode *o, const double *ym, const double *fm){
+   int m;
+   const int n = o->n;
+
+   for(m = 0; m < n; ++m){
+      o->yd[YM_NEW*n + m] = ym[m];
+      o->yd[FM_NEW*n + m] = fm[m];
+   }
+}
+
+/* Keep the step h from (o->t, o->y), with f0, y1 and the stages of the
+   step in o->f0, o->y1 and o->k. The step before is keept as history if
+   this step start at its end. */
+void ode_dense_save(ismael_ode *o, double h, bool mid){
+   int j, m, ns;
+   const int n = o->n;
+   const int *st;
+   double *yd = o->yd;
+
+   if(!o->dense) return;
+
+   o->nh = 0;
+   if((o->nd != 0) && (fabs(o->td + o->hd - o->t) <=
+   8.0 * DBL_EPSILON * fmax(fabs(o->t), fabs(o->hd)))){
+      o->nh = o->md ? 2 : 1;
+      o->tp = o->td;
+      o->hp = o->hd;
+      for(m = 0; m < n; ++m){
+         yd[YP*n + m] = yd[Y0*n + m];
+         yd[FP*n + m] = yd[F0*n + m];
+         yd[YPM*n + m] = yd[YM*n + m];
+         yd[FPM*n + m] = yd[FM*n + m];
+      }
+   }
+
+   o->td = o->t;
+   o->hd = h;
+   o->md = mid;
+   o->nd = 1;
+   for(m = 0; m < n; ++m){
+      yd[Y0*n + m] = o->y[m];
+      yd[F0*n + m] = o->f0[m];
+      yd[DY*n + m] = o->y1[m];
+   }
+   if(mid){
+      for(m = 0; m < n; ++m){
+         yd[YM*n + m] = yd[YM_NEW*n + m];
+         yd[FM*n + m] = yd[FM_NEW*n + m];
+      }
+   }
+   ns = ode_dense_stages(o, &st);
+   for(j = 0; j < ns; ++j)
+      for(m = 0; m < n; ++m)
+         yd[(STAGE + j)*n + m] = o->k[st[j]*n + m];
+}
+
+/* The interpolant y0 + \sum_{m=1}^{nq} alpha_m theta^m of the last step,
+   from the conditions of value (V) and derivative (D) in the nodes theta,
+   the derivative in theta is h f. No evaluation of f is needed. */
+void ode_dense_prepare(ismael_ode *o){
+   int i, j, m, p, nq = 0, ns, q[MAXQ];
+   const int n = o->n;
+   const int *st;
+   bool der[MAXQ];
+   double z[MAXQ], r[MAXQ], zp, *yd = o->yd;
+   long double A[MAXQ][2*MAXQ], w, piv;
+
+   if(o->nd != 1) return;
+
+   /* V and D in 0 (y0 itself), midpoint of rk8, the step before */
+   z[nq] = 0.0; der[nq] = true; q[nq++] = F0;
+   if(o->md){
+      z[nq] = 0.5; der[nq] = false; q[nq++] = YM;
+      z[nq] = 0.5; der[nq] = true; q[nq++] = FM;
+   }
+   if(o->nh > 0){
+      zp = (o->tp - o->td) / o->hd;
+      z[nq] = zp; der[nq] = false; q[nq++] = YP;
+      z[nq] = zp; der[nq] = true; q[nq++] = FP;
+   }
+   if(o->nh > 1){
+      zp = (o->tp + 0.5 * o->hp - o->td) / o->hd;
+      z[nq] = zp; der[nq] = false; q[nq++] = YPM;
+      z[nq] = zp; der[nq] = true; q[nq++] = FPM;
+   }
+
+   /* D in the stages. With 0 they are the nodes of the weights b (Lobatto
+      quadrature), then they give y1 and the last stage (c = 1) is not used
+      with V in 1. For rk8 with the midpoint only the last is used, if the
+      degree is less than 8. */
+   ns = ode_dense_stages(o, &st);
+   for(j = 0; j < ns; ++j){
+      if((o->method == ISMAEL_RK8) && o->md){
+         if((j < ns - 1) || (o->nh > 1)) continue;
+      }else if(j == ns - 1) continue;
+      z[nq] = o->c[st[j]]; der[nq] = true; q[nq++] = STAGE + j;
+   }
+   z[nq] = 1.0; der[nq] = false; q[nq++] = DY;
+
+   /* Inverse of the matrix of the conditions by Gauss-Jordan */
+   for(j = 0; j < nq; ++j){
+      for(m = 0; m < nq; ++m){
+         if(der[j])
+            A[j][m] = (m == 0) ? 1.0L : (m + 1) * powl(z[j], m);
+         else
+            A[j][m] = powl(z[j], m + 1);
+         A[j][nq + m] = (j == m) ? 1.0L : 0.0L;
+      }
+   }
+   for(m = 0; m < nq; ++m){
+      p = m;
+      for(j = m + 1; j < nq; ++j)
+         if(fabsl(A[j][m]) > fabsl(A[p][m])) p = j;
+      for(i = 0; i < 2*nq; ++i){
+         w = A[m][i]; A[m][i] = A[p][i]; A[p][i] = w;
+      }
+      piv = A[m][m];
+      for(i = 0; i < 2*nq; ++i) A[m][i] /= piv;
+      for(j = 0; j < nq; ++j){
+         if((j == m) || (A[j][m] == 0.0L)) continue;
+         w = A[j][m];
+         for(i = 0; i < 2*nq; ++i) A[j][i] -= w * A[m][i];
+      }
+   }
+
+   /* alpha = M^{-1} r for each component */
+   for(i = 0; i < n; ++i){
+      for(j = 0; j < nq; ++j){
+         r[j] = yd[q[j]*n + i];
+         if(der[j]) r[j] *= o->hd;
+         else if(q[j] != DY) r[j] -= yd[Y0*n + i];
+      }
+      for(m = 0; m < nq; ++m){
+         w = 0.0L;
+         for(j = 0; j < nq; ++j) w += A[m][nq + j] * r[j];
+         yd[(ALPHA + m)*n + i] = (double)w;
+      }
+   }
+   o->nq = nq;
+   o->nd = 2;
+}
+
+/* Solution in t of the last step, writen in y */
+void ode_interpolate(ismael_ode *o, double t, double *y){
+   int i, m;
+   const int n = o->n;
+   const double *yd = o->yd;
+   double theta;
+
+   if(o->nd == 0){
+      ismael.error(EXIT_FAILURE,
+      "ode_interpolate: no step keept, set ode->dense = true.\n");
+      return;
+   }
+   ode_dense_prepare(o);
+
+   /* Horner in theta */
+   theta = (t - o->td) / o->hd;
+   for(i = 0; i < n; ++i) y[i] = yd[(ALPHA + o->nq - 1)*n + i];
+   for(m = o->nq - 2; m >= 0; --m)
+      for(i = 0; i < n; ++i) y[i] = yd[(ALPHA + m)*n + i] + theta * y[i];
+   for(i = 0; i < n; ++i) y[i] = yd[Y0*n + i] + theta * y[i];
+}
+
+/* Move the solution back to t of the last step. Only t and y change (and
+   their copy in long double), the norm of the projection, the compensated
+   sums and the interpolant of the step are keept. */
+void ode_dense_restore(ismael_ode *o, double t, double *y){
+   int m;
+
+   ode_interpolate(o, t, y);
+   o->t = t;
+   for(m = 0; m < o->n; ++m) o->y[m] = y[m];
+   if(o->yl == NULL) return;
+   o->tl = t;
+   for(m = 0; m < o->n; ++m) o->yl[m] = y[m];
+}
+
+/* Integrate from o->t to t1 and stop in the first t with g(t, y) = 0.
+   Return 1 if a event is found (o->t is the time of the event and o->y
+   the interpolated solution, just after the change of sign), 0 if t1 is
+   reached or -1 if the step size is smaller than hmin. */
+int ode_evolve_event(ismael_ode *o, double t1, ismael_ode_event g){
+   int i, side;
+   bool dense = o->dense;
+   double dir, g0, g1, a, b, c, ga, gb, gc, tol;
+   double *y = o->y2; /* free after the step */
+
+   o->dense = true;
+   dir = (t1 > o->t) ? 1.0 : -1.0;
+   g0 = g(o->t, o->y, o->params);
+   while((t1 - o->t) * dir > 0.0){
+      if(ode_step_until(o, t1) != 0){
+         o->dense = dense;
+         return -1;
+      }
+      g1 = g(o->t, o->y, o->params);
+      if((g0 == 0.0) || ((g0 > 0.0) == (g1 > 0.0) && (g1 != 0.0))){
+         g0 = g1;
+         continue;
+      }
+
+      /* Root of g in the step, theta in [a, b] and g(a) have the sign of
+         g0 */
+      ode_dense_prepare(o);
+      a = 0.0; ga = g0;
+      b = 1.0; gb = g1;
+      tol = 4.0 * DBL_EPSILON * fmax(fabs(o->td), fabs(o->td + o->hd))
+      / fabs(o->hd);
+      side = 0;
+      for(i = 0; (i < 100) && (b - a > tol) && (gb != 0.0); ++i){
+         c = (a * gb - b * ga) / (gb - ga);
+         if(!((c > a) && (c < b))) c = 0.5 * (a + b);
+         ode_interpolate(o, o->td + c * o->hd, y);
+         gc = g(o->td + c * o->hd, y, o->params);
+         if((gc > 0.0) == (ga > 0.0) && (gc != 0.0)){
+            a = c; ga = gc;
+            if(side == -1) gb *= 0.5;
+            side = -1;
+         }else{
+            b = c; gb = gc;
+            if(side == 1) ga *= 0.5;
+            side = 1;
+         }
+      }
+
+      /* Stop after the root, then g(o->t, o->y) have the new sign */
+      if(b < 1.0) ode_dense_restore(o, o->td + b * o->hd, y);
+      o->dense = dense;
+      return 1;
+   }
+   o->dense = dense;
+   return 0;
+}
+
+#undef Y0
+#undef F0
+#undef YM
+#undef FM
+#undef DY
+#undef YM_NEW
+#undef FM_NEW
+#undef YP
+#undef FP
+#undef YPM
+#undef FPM
+#undef STAGE
+#undef ALPHA
+#undef MAXQ
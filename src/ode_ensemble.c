@@ -0,0 +1,260 @@
+/* *****************************************************************************
+   Ensemble of K systems of ordinary differential equations
+   dy/dt = f(t, y), all with the same f and n components, integrated
+   together with the Runge-Kutta methods of ode.c (rk8 and rk14).
+
+   The ensemble is stored as structure of arrays, the component i of the
+   member m is y[i*K + m], then each stage is a loop over the K members
+   that the compiler vectorize. The function f is called one time for all
+   the ensemble in each stage, f(t, y, dydt, K, params) with t[m] the time
+   of the member m.
+
+   Each member have its own time t[m] and step h[m], the members whose
+   step is accepted advance while the others repeat the step with smaller
+   h, if individual is false all the members use the same step (the error
+   is the maximum of the ensemble).
+
+   Use:
+   ismael.ode.ensemble_init(&ens, ISMAEL_RK8, n, K, f, params);
+   ismael.ode.ensemble_set(&ens, t0, y0); // y0 of n*K values
+   ismael.ode.ensemble_evolve(&ens, t1);
+   ismael.ode.ensemble_free(&ens);
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+void ode_ensemble_init(ismael_ode_ensemble *e, int method, int n, int K,
+ismael_ode_batch_rhs f, void *params){
+   int m;
+   size_t N = (size_t)n * (size_t)K;
+
+   e->s = ode_tableau(method, &e->order, &e->ia, &e->ja, &e->va, &e->c);
+   e->method = method;
+   e->n = n;
+   e->K = K;
+   e->f = f;
+   e->params = params;
+
+   /* Default control of the step */
+   e->adaptive = true;
+   e->individual = true;
+   e->rtol = 1.0e-10;
+   e->atol = 1.0e-12;
+   e->hmin = 0.0;
+   e->hmax = HUGE_VAL;
+   e->nsteps = e->nrejected = e->nfev = 0;
+
+   /* Workspace */
+   e->t = ialloc(K, double);
+   e->h = ialloc(K, double);
+   e->y = ialloc(N, double);
+   e->k = ialloc((size_t)e->s * N, double);
+   e->f0 = ialloc(N, double);
+   e->ytmp = ialloc(N, double);
+   e->y1 = ialloc(N, double);
+   e->y2 = ialloc(N, double);
+   e->tk = ialloc(5 * K, double);
+   e->ok = ialloc(K, int);
+   if((e->t == NULL) || (e->h == NULL) || (e->y == NULL) || (e->k == NULL) ||
+   (e->f0 == NULL) || (e->ytmp == NULL) || (e->y1 == NULL) ||
+   (e->y2 == NULL) || (e->tk == NULL) || (e->ok == NULL))
+      ismael.error(EXIT_FAILURE, "ode_ensemble_init: out of memory.\n");
+   for(m = 0; m < K; ++m){
+      e->t[m] = 0.0;
+      e->h[m] = 1.0e-3;
+   }
+}
+
+void ode_ensemble_set(ismael_ode_ensemble *e, double t, const double *y){
+   int m;
+   size_t i, N = (size_t)e->n * (size_t)e->K;
+
+   for(m = 0; m < e->K; ++m) e->t[m] = t;
+   for(i = 0; i < N; ++i) e->y[i] = y[i];
+}
+
+/* One step of size h[m] of each member from (t, y) to yout,
+   f0 = f(t, y) is given. yout can not be y. */
+void ode_ensemble_rk(ismael_ode_ensemble *e, const double *t,
+const double *y, const double *h, const double *f0, double *yout){
+   int i, p, r, m;
+   const int n = e->n, K = e->K, s = e->s;
+   const size_t N = (size_t)n * (size_t)K;
+   const int *ia = e->ia, *ja = e->ja;
+   double *k = e->k, *ytmp, *kj, *tt = e->tk, *ha = e->tk + K;
+   size_t q;
+
+   for(q = 0; q < N; ++q) k[q] = f0[q];
+   for(i = 1; i <= s; ++i){
+      ytmp = (i < s) ? e->ytmp : yout;
+      for(q = 0; q < N; ++q) ytmp[q] = y[q];
+      for(p = ia[i]; p < ia[i+1]; ++p){
+         for(m = 0; m < K; ++m) ha[m] = e->va[p] * h[m];
+         kj = k + (size_t)ja[p] * N;
+         for(r = 0; r < n; ++r)
+            for(m = 0; m < K; ++m)
+               ytmp[r*K + m] += ha[m] * kj[r*K + m];
+      }
+      if(i < s){
+         for(m = 0; m < K; ++m) tt[m] = t[m] + e->c[i] * h[m];
+         e->f(tt, ytmp, k + (size_t)i * N, K, e->params);
+      }
+   }
+   e->nfev += s - 1;
+}
+
+/* Attempt of a step h[m] of each member, f0 = f(t, y), the solution is in
+   y1 and the estimate of the local error in y2. */
+void ode_ensemble_attempt(ismael_ode_ensemble *e, const double *h){
+   int r, m;
+   const int n = e->n, K = e->K;
+   const size_t N = (size_t)n * (size_t)K;
+   double *hm = e->tk + 2*K, *tm = e->tk + 3*K, d;
+
+   if(e->method == ISMAEL_RK14){
+      /* Error estimate of Feagin, (h/1000) (k_1 - k_33) */
+      ode_ensemble_rk(e, e->t, e->y, h, e->f0, e->y1);
+      for(r = 0; r < n; ++r)
+         for(m = 0; m < K; ++m)
+            e->y2[r*K + m] = 1.0e-3 * h[m] *
+            (e->k[N + r*K + m] - e->k[33*N + r*K + m]);
+      return;
+   }
+
+   /* Two steps h/2 in y1 and one step h in y2 */
+   for(m = 0; m < K; ++m){
+      hm[m] = 0.5 * h[m];
+      tm[m] = e->t[m] + hm[m];
+   }
+   ode_ensemble_rk(e, e->t, e->y, hm, e->f0, e->y2);
+   e->f(tm, e->y2, e->k, K, e->params);
+   ++e->nfev;
+   ode_ensemble_rk(e, tm, e->y2, hm, e->k, e->y1);
+   ode_ensemble_rk(e, e->t, e->y, h, e->f0, e->y2);
+
+   /* Local extrapolation of y1 with the error in y2 */
+   d = 1.0 / (double)((1 << e->order) - 1);
+   for(r = 0; r < n; ++r){
+      for(m = 0; m < K; ++m){
+         e->y2[r*K + m] = (e->y1[r*K + m] - e->y2[r*K + m]) * d;
+         e->y1[r*K + m] += e->y2[r*K + m];
+      }
+   }
+}
+
+/* Integrate all the members from t[m] to t1, the last step of each member
+   is cut to stop at t1. Return 0 or -1 if the step of some member is smaller
+   than hmin. */
+int ode_ensemble_evolve(ismael_ode_ensemble *e, double t1){
+   int r, m, active, failed;
+   const int n = e->n, K = e->K;
+   double *hs = e->tk + 4*K, *err = e->tk + 2*K, sc, d, errmax;
+   int *ok = e->ok;
+
+   for(m = 0; m < K; ++m)
+      if((t1 - e->t[m]) * e->h[m] < 0.0) e->h[m] = -e->h[m];
+
+   for(;;){
+      /* Step of each member, 0 for the members in t1 */
+      active = 0;
+      for(m = 0; m < K; ++m){
+         hs[m] = 0.0;
+         if((t1 - e->t[m]) * e->h[m] <= 0.0) continue;
+         hs[m] = e->h[m];
+         if((e->t[m] + e->h[m] - t1) * e->h[m] >= 0.0) hs[m] = t1 - e->t[m];
+         ++active;
+      }
+      if(active == 0) return 0;
+
+      e->f(e->t, e->y, e->f0, K, e->params);
+      ++e->nfev;
+      ode_ensemble_attempt(e, hs);
+
+      /* Error norm of each member, err is overwritten in the attempt */
+      for(m = 0; m < K; ++m) err[m] = 0.0;
+      if(e->adaptive){
+         for(r = 0; r < n; ++r){
+            for(m = 0; m < K; ++m){
+               sc = e->atol + e->rtol *
+               fmax(fabs(e->y[r*K + m]), fabs(e->y1[r*K + m]));
+               d = e->y2[r*K + m] / sc;
+               err[m] += d * d;
+            }
+         }
+         for(m = 0; m < K; ++m) err[m] = sqrt(err[m] / (double)n);
+      }
+      if(!e->individual){
+         errmax = 0.0;
+         for(m = 0; m < K; ++m) if(hs[m] != 0.0) errmax = fmax(errmax, err[m]);
+         for(m = 0; m < K; ++m) err[m] = errmax;
+      }
+
+      /* Accept or reject the step of each member, the accepted ones are
+         committed before a return by hmin */
+      failed = 0;
+      for(m = 0; m < K; ++m){
+         ok[m] = (hs[m] != 0.0) && (err[m] <= 1.0);
+         if(hs[m] == 0.0) continue;
+         if(ok[m]){
+            ++e->nsteps;
+            if(hs[m] != e->h[m]){
+               e->t[m] = t1; /* the step was cut, keep h */
+            }else{
+               e->t[m] += hs[m];
+               if(e->adaptive)
+                  e->h[m] = ode_new_step(e->order, e->hmax, hs[m], err[m]);
+            }
+         }else{
+            ++e->nrejected;
+            e->h[m] = ode_new_step(e->order, e->hmax, hs[m], err[m]);
+            if((fabs(e->h[m]) < e->hmin) ||
+            (fabs(e->h[m]) <= 4.0 * DBL_EPSILON * fabs(e->t[m])))
+               failed = 1;
+         }
+      }
+      for(r = 0; r < n; ++r)
+         for(m = 0; m < K; ++m)
+            e->y[r*K + m] = ok[m] ? e->y1[r*K + m] : e->y[r*K + m];
+      if(failed) return -1;
+   }
+}
+
+void ode_ensemble_free(ismael_ode_ensemble *e){
+   free(e->ia);
+   free(e->ja);
+   free(e->va);
+   free(e->c);
+   free(e->t);
+   free(e->h);
+   free(e->y);
+   free(e->k);
+   free(e->f0);
+   free(e->ytmp);
+   free(e->y1);
+   free(e->y2);
+   free(e->tk);
+   free(e->ok);
+   e->y = NULL;
+}
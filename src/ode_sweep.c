@@ -0,0 +1,110 @@
+/* *****************************************************************************
+   Integrate N independent initial value problems dy/dt = f(t, y) with the
+   Runge-Kutta methods of ode.c, distributed between the threads of
+   OpenMP (compile with -fopenmp in gcc, else the problems are integrated
+   one by one).
+
+   The cost of the problems is not the same (the steps are adaptive), then
+   each thread take the next problem when finish the last one
+   (schedule(dynamic, 1)), so no thread wait while there are problems.
+   Each thread have its own integrator, allocated one time, and before each
+   problem the options are set again to the defaults (ode_defaults), then
+   what the setup of a problem change do not go to the next one.
+
+   The problem i is initialized by the function of the caller
+   setup(i, y0, ode, rng, params), that write the initial condition in y0
+   and can change ode->params, the tolerances and ode->h. The solution in
+   times[j] is writen in out[(i*nt + j)*n + r], r < n.
+
+   The generator rng of the problem i is mt64 initialized with a seed
+   given by the mix of splitmix64 of (seed, i), then the random numbers of
+   each problem, and out, do not depend of the schedule or the number of
+   threads.
+
+   References:
+   * G. L. Steele, D. Lea and C. H. Flood, "Fast splittable pseudorandom
+     number generators", OOPSLA 2014, pp 453--472.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+/* Seed of the generator of the problem i, the finalizer of splitmix64
+   then near values of i give unrelated seeds */
+uint64_t ode_sweep_seed(uint64_t seed, int i){
+   uint64_t z = seed + (uint64_t)i * UINT64_C(0x9E3779B97F4A7C15);
+
+   z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+   z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+   return z ^ (z >> 31);
+}
+
+/* Return the number of problems that failed, the output of that problems
+   is NAN. */
+int ode_sweep(int method, int n, int N, ismael_ode_rhs f,
+ismael_ode_setup setup, void *params, double t0, const double *times,
+int nt, double *out, uint64_t seed){
+   int failed = 0;
+
+   ISMAEL_OMP(omp parallel reduction(+:failed))
+   {
+      int i, j, r;
+      double *y0, *o;
+      ismael_ode ode;
+      ismael_mt64_state rng;
+
+      ode_init(&ode, method, n, f, params);
+      y0 = ialloc(n, double);
+      if(y0 == NULL) ismael.error(EXIT_FAILURE, "ode_sweep: out of memory.\n");
+
+      ISMAEL_OMP(omp for schedule(dynamic, 1))
+      for(i = 0; i < N; ++i){
+         /* Default options for each problem, the setup can change them */
+         ode_defaults(&ode);
+         ode.params = params;
+         ismael.random.mt64_init(&rng, ode_sweep_seed(seed, i));
+         for(r = 0; r < n; ++r) y0[r] = 0.0;
+         setup(i, y0, &ode, &rng, params);
+         ode_set(&ode, t0, y0);
+
+         for(j = 0; j < nt; ++j){
+            o = out + ((size_t)i * nt + j) * n;
+            if(ode_evolve(&ode, times[j]) != 0){
+               ++failed;
+               for(; j < nt; ++j){
+                  o = out + ((size_t)i * nt + j) * n;
+                  for(r = 0; r < n; ++r) o[r] = NAN;
+               }
+               break;
+            }
+            for(r = 0; r < n; ++r) o[r] = ode.y[r];
+         }
+      }
+
+      free(y0);
+      ode_free(&ode);
+   }
+
+   return failed;
+}
@@ -0,0 +1,159 @@
+/* *****************************************************************************
+   A C99 implementation of
+
+   *** Philox4x32-10 -- counter-based pseudorandom number generator ***
+
+   The generator has no state, the random numbers are a bijection (ten
+   rounds of multiplications and xors) of a counter and a key, then the
+   number n of the stream key is a pure function of (key, n). Any thread can
+   compute any part of the sequence without share state and the result is
+   the same of a serial run.
+
+   The funcion philox return the double number n of the stream key,
+   uniformly distributed on [0, 1) with 53 bits of resolution.
+   The funcion philox_fill compute the numbers n, n+1, ..., n+m-1 of the
+   stream, some counters are processed at same time in arrays (lanes) then
+   the rounds are vectorized by the compiler.
+
+   References:
+   * J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+     "Parallel Random Numbers: As Easy as 1, 2, 3", Proceedings of the
+     International Conference for High Performance Computing, Networking,
+     Storage and Analysis (SC11), 2011.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include <stdint.h> /* Use C99 or latter */
+
+#define M0 UINT32_C(0xD2511F53)
+#define M1 UINT32_C(0xCD9E8D57)
+#define W0 UINT32_C(0x9E3779B9) /* golden ratio */
+#define W1 UINT32_C(0xBB67AE85) /* sqrt(3) - 1 */
+#define ROUNDS 10
+#define LANES 32 /* counters per block of philox_fill */
+
+/* The ten rounds over one counter of 128 bit, in place */
+void philox4x32(uint32_t *ctr, const uint32_t *key){
+   int i;
+   uint32_t k0 = key[0], k1 = key[1];
+   uint64_t p0, p1;
+
+   for(i = 0; i < ROUNDS; ++i){
+      p0 = (uint64_t)M0 * ctr[0];
+      p1 = (uint64_t)M1 * ctr[2];
+      ctr[0] = (uint32_t)(p1 >> 32) ^ ctr[1] ^ k0;
+      ctr[2] = (uint32_t)(p0 >> 32) ^ ctr[3] ^ k1;
+      ctr[1] = (uint32_t)p1;
+      ctr[3] = (uint32_t)p0;
+      k0 += W0;
+      k1 += W1;
+   }
+}
+
+/* Two 32 bit words to a double in [0, 1) with 53 bits, the words are
+   converted by the exponent trick (2^52 + u has the bits of u in the
+   mantissa) that vectorize, instead of a conversion of 64 bit integer. */
+double philox_todouble(uint32_t lo, uint32_t hi){
+   union { uint64_t u; double d; } a, b;
+
+   a.u = (uint64_t)hi | UINT64_C(0x4330000000000000);
+   b.u = (uint64_t)(lo >> 11) | UINT64_C(0x4330000000000000);
+   return (a.d - 0x1p52) * 0x1p-32 + (b.d - 0x1p52) * 0x1p-53;
+}
+#define TO_DOUBLE(lo, hi) philox_todouble(lo, hi)
+
+double philox(uint64_t key, uint64_t n){
+   uint32_t ctr[4], k[2];
+
+   /* Each counter give four words, that is two doubles */
+   ctr[0] = (uint32_t)(n >> 1);
+   ctr[1] = (uint32_t)(n >> 33);
+   ctr[2] = ctr[3] = UINT32_C(0);
+   k[0] = (uint32_t)key;
+   k[1] = (uint32_t)(key >> 32);
+   philox4x32(ctr, k);
+
+   return (n & 1) ? TO_DOUBLE(ctr[2], ctr[3]) : TO_DOUBLE(ctr[0], ctr[1]);
+}
+
+void philox_fill(uint64_t key, uint64_t n, double *x, size_t m){
+   int i, l;
+   uint64_t c, p0, p1;
+   uint32_t c0[LANES], c1[LANES], c2[LANES], c3[LANES], k0, k1, t;
+   double even[LANES], odd[LANES];
+
+   if((m > 0) && (n & 1)){ /* start in the middle of a counter */
+      *(x++) = philox(key, n++);
+      --m;
+   }
+
+   /* The structure of arrays c0, ..., c3 keep LANES counters */
+   while(m >= 2*LANES){
+      c = n >> 1;
+      for(l = 0; l < LANES; ++l){
+         c0[l] = (uint32_t)(c + (uint64_t)l);
+         c1[l] = (uint32_t)((c + (uint64_t)l) >> 32);
+         c2[l] = c3[l] = UINT32_C(0);
+      }
+      k0 = (uint32_t)key;
+      k1 = (uint32_t)(key >> 32);
+      for(i = 0; i < ROUNDS; ++i){
+         for(l = 0; l < LANES; ++l){
+            p0 = (uint64_t)M0 * c0[l];
+            p1 = (uint64_t)M1 * c2[l];
+            t = c1[l];
+            c0[l] = (uint32_t)(p1 >> 32) ^ t ^ k0;
+            c1[l] = (uint32_t)p1;
+            t = c3[l];
+            c2[l] = (uint32_t)(p0 >> 32) ^ t ^ k1;
+            c3[l] = (uint32_t)p0;
+         }
+         k0 += W0;
+         k1 += W1;
+      }
+      for(l = 0; l < LANES; ++l){
+         even[l] = TO_DOUBLE(c0[l], c1[l]);
+         odd[l] = TO_DOUBLE(c2[l], c3[l]);
+      }
+      for(l = 0; l < LANES; ++l){
+         x[2*l] = even[l];
+         x[2*l+1] = odd[l];
+      }
+      n += 2*LANES;
+      x += 2*LANES;
+      m -= 2*LANES;
+   }
+
+   while(m > 0){
+      *(x++) = philox(key, n++);
+      --m;
+   }
+}
+#undef M0
+#undef M1
+#undef W0
+#undef W1
+#undef ROUNDS
+#undef LANES
+#undef TO_DOUBLE
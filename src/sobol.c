@@ -0,0 +1,185 @@
+/* *****************************************************************************
+   Sobol low-discrepancy (quasi-random) sequence in d <= 21 dimensions, for
+   quasi-Monte Carlo integration.
+
+   The coordinate j of the point n is the xor of the direction numbers
+   v_j[k] of the bits k of the Gray code g(n) = n ^ (n >> 1). As g(n+1) and
+   g(n) differ only in the bit c = (trailing zeros of n+1), the next point
+   is x ^ v_j[c] (Antonov and Saleev), O(1) per point, and the point n is
+   computed directly from g(n) (sobol_seek), then any thread can start in
+   any part of the sequence.
+
+   The direction numbers of the first dimension are v[k] = 2^-(k+1), the
+   other ones come from the primitive polynomials and the initial numbers
+   m_k of Joe and Kuo. The numbers are 64 bit fractions, the doubles have
+   53 bits of resolution and the sequence have 2^64 points.
+
+   Optionally the sequence is scrambled with numbers of mt64: a random
+   lower triangular binary matrix is applied to the direction numbers and
+   the points are xored with a random shift (linear matrix scrambling and
+   digital shift of Matousek). The scrambled points keep the properties of
+   the nets and are uniform in [0, 1)^d, then independent scramblings give
+   an estimate of the error of the integral.
+
+   References:
+   * I. M. Sobol, "On the distribution of points in a cube and the
+     approximate evaluation of integrals", USSR Computational Mathematics
+     and Mathematical Physics, Vol. 7, 1967, pp 86--112.
+   * S. Joe and F. Y. Kuo, "Constructing Sobol sequences with better
+     two-dimensional projections", SIAM Journal on Scientific Computing,
+     Vol. 30, 2008, pp 2635--2654 (file new-joe-kuo-6.21201).
+   * J. Matousek, "On the L2-discrepancy for anchored boxes", Journal of
+     Complexity, Vol. 14, 1998, pp 527--556.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+#define SOBOL_DIM 21
+
+/* Degree s, inner coefficients a and initial m_1, ..., m_s of the
+   dimensions 2, ..., 21 */
+static const int sobol_s[SOBOL_DIM-1] = {
+   1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6, 7, 7
+};
+static const int sobol_a[SOBOL_DIM-1] = {
+   0, 1, 1, 2, 1, 4, 2, 4, 7, 11, 13, 14, 1, 13, 16, 19, 22, 25, 1, 4
+};
+static const int sobol_m[SOBOL_DIM-1][7] = {
+   {1}, {1, 3}, {1, 3, 1}, {1, 1, 1}, {1, 1, 3, 3}, {1, 3, 5, 13},
+   {1, 1, 5, 5, 17}, {1, 1, 5, 5, 5}, {1, 1, 7, 11, 19}, {1, 1, 5, 1, 1},
+   {1, 1, 1, 3, 11}, {1, 3, 5, 5, 31}, {1, 3, 3, 9, 7, 49},
+   {1, 1, 1, 15, 21, 21}, {1, 3, 1, 13, 27, 49}, {1, 1, 1, 15, 7, 5},
+   {1, 3, 1, 15, 13, 25}, {1, 1, 5, 5, 19, 61}, {1, 3, 7, 11, 23, 15, 103},
+   {1, 3, 7, 13, 13, 15, 69}
+};
+
+static inline uint64_t sobol_parity(uint64_t x){
+   x ^= x >> 32;
+   x ^= x >> 16;
+   x ^= x >> 8;
+   x ^= x >> 4;
+   x ^= x >> 2;
+   x ^= x >> 1;
+   return x & 1;
+}
+
+/* The next point will be the point n */
+void sobol_seek(ismael_sobol *s, uint64_t n){
+   int j, k;
+   uint64_t g = n ^ (n >> 1);
+
+   for(j = 0; j < s->d; ++j){
+      s->x[j] = s->shift[j];
+      for(k = 0; k < 64; ++k)
+         if((g >> k) & 1) s->x[j] ^= s->v[k * s->d + j];
+   }
+   s->n = n;
+}
+
+/* d dimensions, scrambled with numbers of state if it is not NULL */
+void sobol_init(ismael_sobol *s, int d, ismael_mt64_state *state){
+   int j, k, i, deg, a;
+   uint64_t v[64], L, w, row[64];
+
+   if((d < 1) || (d > SOBOL_DIM))
+      ismael.error(EXIT_FAILURE, "sobol_init: the dimension must be in "
+      "[1, 21].\n");
+   s->d = d;
+   s->v = ialloc(64 * d, uint64_t);
+   s->x = ialloc(d, uint64_t);
+   s->shift = ialloc(d, uint64_t);
+   if((s->v == NULL) || (s->x == NULL) || (s->shift == NULL))
+      ismael.error(EXIT_FAILURE, "sobol_init: out of memory.\n");
+
+   for(j = 0; j < d; ++j){
+      if(j == 0){
+         for(k = 0; k < 64; ++k) v[k] = UINT64_C(1) << (63 - k);
+      }else{
+         deg = sobol_s[j-1];
+         a = sobol_a[j-1];
+         for(k = 0; k < deg; ++k)
+            v[k] = (uint64_t)sobol_m[j-1][k] << (63 - k);
+         for(k = deg; k < 64; ++k){
+            v[k] = v[k-deg] ^ (v[k-deg] >> deg);
+            for(i = 1; i < deg; ++i)
+               if((a >> (deg - 1 - i)) & 1) v[k] ^= v[k-i];
+         }
+      }
+      s->shift[j] = 0;
+
+      /* The digit r (bit 63 - r) of L v is the parity of the row r of L
+         and v, the row r have 1 in the diagonal and random bits in the r
+         digits before it. The same L for all the v of the dimension */
+      if(state != NULL){
+         for(i = 0; i < 64; ++i){
+            L = (i == 0) ? 0 :
+            mt19937_64_genrand(state) & ~(UINT64_MAX >> i);
+            row[i] = L | (UINT64_C(1) << (63 - i));
+         }
+         for(k = 0; k < 64; ++k){
+            w = 0;
+            for(i = 0; i < 64; ++i)
+               w |= sobol_parity(row[i] & v[k]) << (63 - i);
+            v[k] = w;
+         }
+         s->shift[j] = mt19937_64_genrand(state);
+      }
+      /* The numbers of the same bit k are contiguous, v[k*d + j] */
+      for(k = 0; k < 64; ++k) s->v[k * d + j] = v[k];
+   }
+   sobol_seek(s, 0);
+}
+
+/* The point n in x[0], ..., x[d-1], and go to the point n+1 */
+void sobol_next(ismael_sobol *s, double *x){
+   int j, c;
+   uint64_t m;
+   const uint64_t *v;
+
+   for(j = 0; j < s->d; ++j)
+      x[j] = (double)(int64_t)(s->x[j] >> 11) * 0x1.0p-53;
+   m = ++s->n;
+   if(m == 0) return; /* the end of the sequence */
+   for(c = 0; !((m >> c) & 1); ++c);
+   v = s->v + c * s->d;
+   for(j = 0; j < s->d; ++j) s->x[j] ^= v[j];
+}
+
+/* n points in the rows of the matrix x[i*d + j] */
+void sobol_fill(ismael_sobol *s, double *x, size_t n){
+   size_t i;
+
+   for(i = 0; i < n; ++i) sobol_next(s, x + i * s->d);
+}
+
+void sobol_free(ismael_sobol *s){
+   free(s->v);
+   free(s->x);
+   free(s->shift);
+   s->v = s->x = s->shift = NULL;
+   s->d = 0;
+}
+
+#undef SOBOL_DIM
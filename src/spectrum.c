@@ -0,0 +1,170 @@
+/* *****************************************************************************
+   Autocorrelation function and power spectrum of sequences (e.g. of
+   random.distance, random.fourier or random.bernoulli), averaged over
+   many realizations of the same length n, in O(n log n) by fft.
+
+   For each sequence x the mean is removed and the sequence is padded with
+   zeros to L >= 2n (a power of 2), then the inverse transform of |X|^2 is
+   the linear (not circular) correlation
+   sum_i (x_i - <x>)(x_{i+r} - <x>), divided by n - r.
+
+   The periodogram is S(f) = |sum_i w_i x_i exp(-2 pi i f i)|^2 / sum_i w_i^2,
+   for white noise of variance s^2 it is s^2 at all the frequencies. Without
+   segments it is |X|^2 of the transform of the correlation, in the L/2 + 1
+   frequencies f = j/L. With segments of M < n numbers (Welch) the sequence
+   is divided in segments with overlap of M/2, multiplied by the Hann window
+   and the periodograms of the segments are averaged, in the frequencies
+   f = j/M, with less variance and less resolution.
+
+   All the memory, with the plans of the transforms of size L and M, is
+   allocated by spectrum_init, then spectrum_add only accumulate the sums
+   of one more realization.
+
+   References:
+   * P. D. Welch, "The use of fast Fourier transform for the estimation of
+     power spectra: A method based on time averaging over short, modified
+     periodograms", IEEE Transactions on Audio and Electroacoustics,
+     Vol. 15, 1967, pp 70--73.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+/* Sequences of n numbers, segments of M numbers (M <= 0 or M >= n for the
+   periodogram of all the sequence) */
+void spectrum_init(ismael_spectrum *s, int n, int M){
+   int i;
+
+   if(n < 2)
+      ismael.error(EXIT_FAILURE, "spectrum_init: the sequences need at least "
+      "2 numbers.\n");
+   s->n = n;
+   for(s->L = 1; s->L < 2 * n; s->L <<= 1);
+   s->M = ((M <= 0) || (M >= n)) ? 0 : M;
+   if((s->M > 0) && (s->M < 2))
+      ismael.error(EXIT_FAILURE, "spectrum_init: the segments need at least "
+      "2 numbers.\n");
+   s->np = (s->M > 0) ? s->M / 2 + 1 : s->L / 2 + 1;
+   s->count = 0;
+   s->acf = ialloc(n, double);
+   s->psd = ialloc(s->np, double);
+   s->work = ialloc(s->L, double _Complex);
+   s->window = NULL;
+   s->seg = NULL;
+   if((s->acf == NULL) || (s->psd == NULL) || (s->work == NULL))
+      ismael.error(EXIT_FAILURE, "spectrum_init: out of memory.\n");
+   fft_plan_init(&s->planL, s->L);
+   fft_plan_init(&s->planM, s->M);
+   for(i = 0; i < n; ++i) s->acf[i] = 0.0;
+   for(i = 0; i < s->np; ++i) s->psd[i] = 0.0;
+   if(s->M > 0){
+      s->window = ialloc(s->M, double);
+      s->seg = ialloc(s->M, double _Complex);
+      if((s->window == NULL) || (s->seg == NULL))
+         ismael.error(EXIT_FAILURE, "spectrum_init: out of memory.\n");
+      for(i = 0; i < s->M; ++i)
+         s->window[i] = 0.5 - 0.5 * cos(2.0 * M_PI * i / s->M);
+   }
+}
+
+/* Add the sequence x of n numbers */
+void spectrum_add(ismael_spectrum *s, const double *x){
+   int i, j, k, n = s->n, L = s->L, M = s->M, nseg;
+   double mean, w2, a;
+
+   mean = 0.0;
+   for(i = 0; i < n; ++i) mean += x[i];
+   mean /= (double)n;
+
+   for(i = 0; i < n; ++i) s->work[i] = x[i] - mean;
+   for(i = n; i < L; ++i) s->work[i] = 0.0;
+   fft_plan_exec(&s->planL, s->work, -1);
+   for(j = 0; j < L; ++j){
+      a = creal(s->work[j] * conj(s->work[j]));
+      if((M == 0) && (j < s->np)) s->psd[j] += a / (double)n;
+      s->work[j] = a;
+   }
+   fft_plan_exec(&s->planL, s->work, +1);
+   for(i = 0; i < n; ++i)
+      s->acf[i] += creal(s->work[i]) / ((double)L * (double)(n - i));
+
+   /* Welch */
+   if(M > 0){
+      nseg = (n - M) / (M / 2) + 1;
+      w2 = 0.0;
+      for(i = 0; i < M; ++i) w2 += s->window[i] * s->window[i];
+      for(k = 0; k < nseg; ++k){
+         const double *y = x + k * (M / 2);
+         for(i = 0; i < M; ++i) s->seg[i] = s->window[i] * (y[i] - mean);
+         fft_plan_exec(&s->planM, s->seg, -1);
+         for(j = 0; j < s->np; ++j)
+            s->psd[j] += creal(s->seg[j] * conj(s->seg[j])) /
+            (w2 * (double)nseg);
+      }
+   }
+   ++s->count;
+}
+
+/* matrix[0][r] = r and matrix[1][r] = C(r) / C(0), r = 0, ..., n-1 */
+double **spectrum_correlation(const ismael_spectrum *s){
+   int r;
+   double **_c;
+
+   _c = ialloc(2, double*);
+   _c[0] = ialloc(s->n, double);
+   _c[1] = ialloc(s->n, double);
+   for(r = 0; r < s->n; ++r){
+      _c[0][r] = (double)r;
+      _c[1][r] = (s->acf[0] > 0.0) ? s->acf[r] / s->acf[0] : 0.0;
+   }
+   return _c;
+}
+
+/* matrix[0][j] = f_j and matrix[1][j] = S(f_j), j = 0, ..., np-1 */
+double **spectrum_power(const ismael_spectrum *s){
+   int j;
+   double **_p;
+
+   _p = ialloc(2, double*);
+   _p[0] = ialloc(s->np, double);
+   _p[1] = ialloc(s->np, double);
+   for(j = 0; j < s->np; ++j){
+      _p[0][j] = (double)j / (double)((s->M > 0) ? s->M : s->L);
+      _p[1][j] = (s->count > 0) ? s->psd[j] / (double)s->count : 0.0;
+   }
+   return _p;
+}
+
+void spectrum_free(ismael_spectrum *s){
+   free(s->acf);
+   free(s->psd);
+   free(s->work);
+   free(s->window);
+   free(s->seg);
+   fft_plan_free(&s->planL);
+   fft_plan_free(&s->planM);
+   s->acf = s->psd = s->window = NULL;
+   s->work = s->seg = NULL;
+   s->n = s->np = 0;
+}
@@ -0,0 +1,162 @@
+/* *****************************************************************************
+   Transfer matrices of the 1D chain with hopping 1 and site energies
+   eps_i (e.g. of ismael.random.*), for many energies E at same time:
+
+   psi_{i+1} = (E - eps_i) psi_i - psi_{i-1},
+
+   and the Lyapunov exponent gamma(E) = lim (1/N) ln |psi_N|, the inverse of
+   the localization length. For hopping t use E/t and eps_i/t.
+
+   The chain is given chunk by chunk (transfer_add), then the site energies
+   can be generated on the fly and the chain never is all in the memory.
+   The energies are advanced in tiles of 32 lanes (SIMD, many independent
+   recurrences hide the latency of the multiplication) kept in registers,
+   the sites of a chunk are processed in blocks that stay in the cache
+   while all the tiles pass, then each chunk is read one time from the
+   memory. If compiled with OpenMP the tiles are divided between the
+   threads (each thread always have the same tiles).
+
+   The amplitudes are renormalized after each 16 sites only if out of
+   [2^-256, 2^256], the scale is a power of 2 (frexp/ldexp, without round
+   off) and the exponents are accumulated.
+
+   Use:
+   ismael.transfer.init(&T, E, m);
+   ismael.transfer.add(&T, eps, N); // for each chunk of the chain
+   ismael.transfer.lyapunov(&T, gamma);
+   ismael.transfer.free(&T);
+
+   References:
+   * A. MacKinnon and B. Kramer, "The scaling theory of electrons in
+     disordered solids", Zeitschrift fur Physik B, Vol. 53, 1983, pp 1--13.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+#define TRANSFER_LANES 32
+#define TRANSFER_BLOCK 2048 /* sites of a block of the chunk */
+
+/* Energies E[0..m-1], the initial condition is psi_{-1} = 0, psi_0 = 1 */
+void transfer_init(ismael_transfer *T, const double *E, int m){
+   int k, mp;
+
+   mp = (m + TRANSFER_LANES - 1) / TRANSFER_LANES * TRANSFER_LANES;
+   T->m = m;
+   T->n = 0;
+   T->E = ialloc(4 * mp, double);
+   if(T->E == NULL) ismael.error(EXIT_FAILURE, "transfer: out of memory.\n");
+   T->psi0 = T->E + mp;
+   T->psi1 = T->psi0 + mp;
+   T->scale = T->psi1 + mp;
+   for(k = 0; k < mp; ++k){
+      T->E[k] = (k < m) ? E[k] : 0.0; /* lanes of the last tile */
+      T->psi0[k] = 0.0;
+      T->psi1[k] = 1.0;
+      T->scale[k] = 0.0;
+   }
+}
+
+/* Sites eps[0..N-1] for the tile of energies E */
+void transfer_tile(const double *E, double *psi0, double *psi1,
+double *scale, const double *eps, size_t N){
+   int k, ex;
+   size_t i, j, jmax;
+   double a[TRANSFER_LANES], b[TRANSFER_LANES], c, s;
+   bool out;
+
+   for(k = 0; k < TRANSFER_LANES; ++k){
+      a[k] = psi0[k];
+      b[k] = psi1[k];
+   }
+   for(j = 0; j < N; j += 16){
+      jmax = (j + 16 < N) ? j + 16 : N;
+      for(i = j; i < jmax; ++i){
+         for(k = 0; k < TRANSFER_LANES; ++k){
+            c = (E[k] - eps[i]) * b[k] - a[k];
+            a[k] = b[k];
+            b[k] = c;
+         }
+      }
+
+      out = false;
+      for(k = 0; k < TRANSFER_LANES; ++k){
+         s = fmax(fabs(a[k]), fabs(b[k]));
+         out |= (s > 0x1p256) || (s < 0x1p-256);
+      }
+      if(!out) continue;
+      for(k = 0; k < TRANSFER_LANES; ++k){
+         frexp(fmax(fabs(a[k]), fabs(b[k])), &ex);
+         a[k] = ldexp(a[k], -ex);
+         b[k] = ldexp(b[k], -ex);
+         scale[k] += (double)ex;
+      }
+   }
+   for(k = 0; k < TRANSFER_LANES; ++k){
+      psi0[k] = a[k];
+      psi1[k] = b[k];
+   }
+}
+
+/* Advance the m energies by the sites eps[0..N-1] of the chain */
+void transfer_add(ismael_transfer *T, const double *eps, size_t N){
+   const int tiles = (T->m + TRANSFER_LANES - 1) / TRANSFER_LANES;
+
+   ISMAEL_OMP(omp parallel)
+   {
+      int t;
+      size_t b;
+
+      for(b = 0; b < N; b += TRANSFER_BLOCK){
+         ISMAEL_OMP(omp for schedule(static) nowait)
+         for(t = 0; t < tiles; ++t)
+            transfer_tile(T->E + t * TRANSFER_LANES,
+            T->psi0 + t * TRANSFER_LANES, T->psi1 + t * TRANSFER_LANES,
+            T->scale + t * TRANSFER_LANES, eps + b,
+            (N - b < TRANSFER_BLOCK) ? N - b : TRANSFER_BLOCK);
+      }
+   }
+   T->n += (long long)N;
+}
+
+/* gamma[k] = (1/N) ln |psi_N| of the energy E[k] */
+void transfer_lyapunov(const ismael_transfer *T, double *gamma){
+   int k;
+   double s;
+
+   for(k = 0; k < T->m; ++k){
+      s = fmax(fabs(T->psi0[k]), fabs(T->psi1[k]));
+      gamma[k] = (T->n > 0) ?
+      (T->scale[k] * M_LN2 + log(s)) / (double)T->n : 0.0;
+   }
+}
+
+void transfer_free(ismael_transfer *T){
+   free(T->E);
+   T->E = T->psi0 = T->psi1 = T->scale = NULL;
+   T->m = 0;
+}
+
+#undef TRANSFER_LANES
+#undef TRANSFER_BLOCK
@@ -0,0 +1,235 @@
+/* *****************************************************************************
+   Eigenvalues and eigenvectors of the real symmetric tridiagonal matrix T
+   with diagonal d[0..n-1] and off-diagonal e[0..n-2] (T[i][i+1] = e[i]),
+   e.g. the 1D Anderson chain with the site energies of ismael.random.* in d
+   and the hopping in e. If e is NULL all the off-diagonal elements are 1
+   (the eigenvalues and |v_i| are the same for -1).
+
+   The number of eigenvalues smaller than x is the number of negative
+   pivots of the LDL^T factorization of T - x I (Sturm sequence)
+
+   q_0 = d_0 - x,   q_i = d_i - x - e_{i-1}^2 / q_{i-1},
+
+   O(n) and without memory. The eigenvalue k (ascending order) is found by
+   bisection of the Gershgorin interval with this count, to the round off,
+   and each eigenvalue is independent of the others (they are distributed
+   between the threads if compiled with OpenMP). Then only the eigenvalues
+   that matter are computed, in O(n) each, and not all in O(n^3).
+
+   The eigenvectors are computed by inverse iteration: the systems
+   (T - w I) x_{j+1} = x_j are solved by Gaussian elimination with partial
+   pivoting in O(n), and the vectors of eigenvalues closer than 10^-3 |T|
+   (cluster) are orthogonalized by Gram-Schmidt [LAPACK dstein].
+
+   The participation number of a normalized or not vector v is
+   P = (\sum_i v_i^2)^2 / \sum_i v_i^4, P ~ 1 for a localized state and
+   P ~ n for a extended state.
+
+   References:
+   * W. Barth, R. S. Martin and J. H. Wilkinson, "Calculation of the
+     eigenvalues of a symmetric tridiagonal matrix by the method of
+     bisection", Numerische Mathematik, Vol. 9, 1967, pp 386--393.
+   * J. W. Demmel, "Applied Numerical Linear Algebra", SIAM, 1997,
+     section 5.3.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+/* Number of eigenvalues smaller than x */
+int tridiag_sturm(const double *d, const double *e, int n, double x,
+double pivmin){
+   int i, c;
+   double q;
+
+   q = d[0] - x;
+   if(fabs(q) < pivmin) q = -pivmin;
+   c = (q < 0.0);
+   for(i = 1; i < n; ++i){
+      q = d[i] - x - ((e == NULL) ? 1.0 : e[i-1] * e[i-1]) / q;
+      if(fabs(q) < pivmin) q = -pivmin;
+      c += (q < 0.0);
+   }
+   return c;
+}
+
+/* Gershgorin interval [lo, hi], the norm of T and the smallest pivot */
+void tridiag_bounds(const double *d, const double *e, int n, double *lo,
+double *hi, double *norm, double *pivmin){
+   int i;
+   double r, emax = 1.0;
+
+   *lo = DBL_MAX;
+   *hi = -DBL_MAX;
+   for(i = 0; i < n; ++i){
+      r = 0.0;
+      if(i > 0) r += (e == NULL) ? 1.0 : fabs(e[i-1]);
+      if(i < n - 1) r += (e == NULL) ? 1.0 : fabs(e[i]);
+      if(i < n - 1) emax = fmax(emax, (e == NULL) ? 1.0 : e[i] * e[i]);
+      *lo = fmin(*lo, d[i] - r);
+      *hi = fmax(*hi, d[i] + r);
+   }
+   *norm = fmax(fabs(*lo), fabs(*hi));
+   *lo -= 2.0 * DBL_EPSILON * *norm + DBL_MIN;
+   *hi += 2.0 * DBL_EPSILON * *norm + DBL_MIN;
+   *pivmin = DBL_MIN * emax;
+}
+
+int tridiag_count(const double *d, const double *e, int n, double x){
+   double lo, hi, norm, pivmin;
+
+   tridiag_bounds(d, e, n, &lo, &hi, &norm, &pivmin);
+   return tridiag_sturm(d, e, n, x, pivmin);
+}
+
+/* Eigenvalues k = il, ..., iu (0 <= il <= iu < n, ascending order) in
+   w[0], ..., w[iu - il] */
+void tridiag_eigenvalues(const double *d, const double *e, int n, int il,
+int iu, double *w){
+   int k;
+   double lo, hi, norm, pivmin;
+
+   if((il < 0) || (iu >= n) || (il > iu))
+      ismael.error(EXIT_FAILURE, "tridiag_eigenvalues: invalid indices.\n");
+   tridiag_bounds(d, e, n, &lo, &hi, &norm, &pivmin);
+
+   ISMAEL_OMP(omp parallel for schedule(dynamic, 16))
+   for(k = il; k <= iu; ++k){
+      double a = lo, b = hi, x;
+
+      /* count(a) <= k < count(b) */
+      while(b - a > 2.0 * DBL_EPSILON * fmax(fabs(a), fabs(b)) + pivmin){
+         x = 0.5 * (a + b);
+         if((x <= a) || (x >= b)) break;
+         if(tridiag_sturm(d, e, n, x, pivmin) > k) b = x;
+         else a = x;
+      }
+      w[k - il] = 0.5 * (a + b);
+   }
+}
+
+/* Eigenvectors of the m eigenvalues w (ascending order) of T, the vector j
+   is V[j*n + i] with norm 1 */
+void tridiag_eigenvectors(const double *d, const double *e, int n,
+const double *w, int m, double *V){
+   int i, j, c, it, first = 0, *piv;
+   double lo, hi, norm, pivmin, tiny, lambda = 0.0, l, s, t0, t1;
+   double *u0, *u1, *u2, *lw, *x, *v;
+
+   tridiag_bounds(d, e, n, &lo, &hi, &norm, &pivmin);
+   tiny = DBL_EPSILON * norm + DBL_MIN;
+   u0 = ialloc(4 * n, double);
+   piv = ialloc(n, int);
+   if((u0 == NULL) || (piv == NULL))
+      ismael.error(EXIT_FAILURE, "tridiag_eigenvectors: out of memory.\n");
+   u1 = u0 + n; u2 = u1 + n; lw = u2 + n;
+
+   for(j = 0; j < m; ++j){
+      /* Cluster of eigenvalues, the equal ones are perturbed */
+      if((j == 0) || (w[j] - w[j-1] > 1.0e-3 * norm)){
+         first = j;
+         lambda = w[j];
+      }else{
+         lambda = fmax(w[j], lambda + 10.0 * DBL_EPSILON * fabs(lambda)
+         + tiny);
+      }
+
+      /* LU with partial pivoting of T - lambda I, the row i of U is
+         (u0[i], u1[i], u2[i]) in the columns i, i+1, i+2 */
+      for(i = 0; i < n; ++i){
+         u0[i] = d[i] - lambda;
+         u1[i] = (i < n - 1) ? ((e == NULL) ? 1.0 : e[i]) : 0.0;
+         u2[i] = 0.0;
+      }
+      for(i = 0; i < n - 1; ++i){
+         s = (e == NULL) ? 1.0 : e[i]; /* T[i+1][i] */
+         if(fabs(u0[i]) >= fabs(s)){
+            piv[i] = 0;
+            if(u0[i] == 0.0) u0[i] = tiny;
+            l = s / u0[i];
+            u0[i+1] -= l * u1[i];
+         }else{
+            piv[i] = 1;
+            l = u0[i] / s;
+            t0 = u0[i+1];
+            t1 = u1[i+1];
+            u0[i+1] = u1[i] - l * t0;
+            u1[i+1] = -l * t1;
+            u0[i] = s;
+            u1[i] = t0;
+            u2[i] = t1;
+         }
+         lw[i] = l;
+      }
+      if(fabs(u0[n-1]) < tiny) u0[n-1] = copysign(tiny, u0[n-1]);
+
+      /* Start with a random vector and three iterations */
+      v = V + (size_t)j * n;
+      x = v;
+      for(i = 0; i < n; ++i) x[i] = ismael.random.philox(j, i) - 0.5;
+      for(it = 0; it < 3; ++it){
+         for(i = 0; i < n - 1; ++i){
+            if(piv[i]){
+               s = x[i]; x[i] = x[i+1]; x[i+1] = s;
+            }
+            x[i+1] -= lw[i] * x[i];
+         }
+         x[n-1] /= u0[n-1];
+         if(n > 1) x[n-2] = (x[n-2] - u1[n-2] * x[n-1]) / u0[n-2];
+         for(i = n - 3; i >= 0; --i)
+            x[i] = (x[i] - u1[i] * x[i+1] - u2[i] * x[i+2]) / u0[i];
+
+         /* Orthogonal to the other vectors of the cluster */
+         for(c = first; c < j; ++c){
+            const double *vc = V + (size_t)c * n;
+            s = 0.0;
+            for(i = 0; i < n; ++i) s += vc[i] * x[i];
+            for(i = 0; i < n; ++i) x[i] -= s * vc[i];
+         }
+
+         s = 0.0;
+         for(i = 0; i < n; ++i) s = fmax(s, fabs(x[i]));
+         for(i = 0; i < n; ++i) x[i] /= s;
+      }
+      s = 0.0;
+      for(i = 0; i < n; ++i) s += x[i] * x[i];
+      s = 1.0 / sqrt(s);
+      for(i = 0; i < n; ++i) x[i] *= s;
+   }
+
+   free(u0);
+   free(piv);
+}
+
+double tridiag_participation(const double *v, int n){
+   int i;
+   double s2 = 0.0, s4 = 0.0, v2;
+
+   for(i = 0; i < n; ++i){
+      v2 = v[i] * v[i];
+      s2 += v2;
+      s4 += v2 * v2;
+   }
+   return s2 * s2 / s4;
+}
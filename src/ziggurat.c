@@ -0,0 +1,456 @@
+/* *****************************************************************************
+   Ziggurat method for normal (Gaussian) and exponential random numbers,
+   driven by the generator mt64 (random.mt64_init).
+
+   The density f(x) (exp(-x^2/2) for the normal, exp(-x) for the
+   exponential) is covered by C layers of the same area v, the layer i is
+   the rectangle [0, x_i] x [f(x_i), f(x_{i+1})] (x_0 = v/f(r) is the base
+   with the tail x > r). With one 64 bit number are chosen the layer i, the
+   sign and x = U x_i, and if x < x_{i+1} (98.8% for the normal, 98.9% for
+   the exponential) x is returned without any function of libm. Else x is
+   tested in the wedge of the layer by one more uniform number, or in the
+   base a number of the tail is generated (Marsaglia).
+
+   The tables x_i and f(x_i) are precomputed (C = 128 for the normal and
+   C = 256 for the exponential).
+
+   The funcions *_fill write n numbers in the buffer of the caller: the 64
+   bit numbers of a block are generated and the fast test is made for all
+   the block (a loop without branches), then only the rejected ones are
+   completed one by one. The sequence is not the same of n calls of
+   ziggurat_normal (the rejected ones use the numbers after the block).
+
+   References:
+   * G. Marsaglia and W. W. Tsang, "The Ziggurat Method for Generating
+     Random Variables", Journal of Statistical Software, Vol. 5, No. 8,
+     2000.
+   * J. A. Doornik, "An Improved Ziggurat Method to Generate Normal Random
+     Samples", 2005.
+   *****************************************************************************
+   E-mail: ismaellxd@gmail.com
+   Site: https://ismaeldamiao.github.io/
+   *****************************************************************************
+   Copyright (c) 2022 I.F.F. dos SANTOS (Ismael Damiao)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy 
+   of this software and associated documentation files (the “Software”), to 
+   deal in the Software without restriction, including without limitation the 
+   rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+   sell copies of the Software, and to permit persons to whom the Software is 
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in 
+   all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+   IN THE SOFTWARE.
+***************************************************************************** */
+#include "../ismael.h"
+
+#define ZIGGURAT_NR 3.442619855899 /* start of the tail of the normal */
+#define ZIGGURAT_ER 7.69711747013104972 /* of the exponential */
+#define ZIGGURAT_BLOCK 256
+
+/* x_i of the 128 layers of the normal, x_0 = v / f(r) and x_128 = 0 */
+const double ziggurat_nx[129] = {
+   3.71308624674255050e+00, 3.44261985589900021e+00, 3.22308498458114157e+00,
+   3.08322885821686832e+00, 2.97869625264778026e+00, 2.89434400702152894e+00,
+   2.82312535054891045e+00, 2.76116937238717686e+00, 2.70611357312181955e+00,
+   2.65640641126135968e+00, 2.61097224843184739e+00, 2.56903362592493778e+00,
+   2.53000967238882746e+00, 2.49345452209537211e+00, 2.45901817741183049e+00,
+   2.42642064553374981e+00, 2.39543427801106246e+00, 2.36587137011763859e+00,
+   2.33757524133923678e+00, 2.31041368369876299e+00, 2.28427405967747177e+00,
+   2.25905957386919853e+00, 2.23468639559097948e+00, 2.21108140887870341e+00,
+   2.18818043207604918e+00, 2.16592679374892194e+00, 2.14427018236039535e+00,
+   2.12316570867397658e+00, 2.10257313518923850e+00, 2.08245623799201685e+00,
+   2.06278227450830842e+00, 2.04352153665506764e+00, 2.02464697337738553e+00,
+   2.00613386996347209e+00, 1.98795957412761992e+00, 1.97010326085432652e+00,
+   1.95254572955355665e+00, 1.93526922829662285e+00, 1.91825730086450985e+00,
+   1.90149465310515109e+00, 1.88496703570775903e+00, 1.86866114099448866e+00,
+   1.85256451172809111e+00, 1.83666546025844601e+00, 1.82095299659612553e+00,
+   1.80541676421922848e+00, 1.79004698259985862e+00, 1.77483439558606948e+00,
+   1.75977022489959345e+00, 1.74484612811380035e+00, 1.73005416056373051e+00,
+   1.71538674071366759e+00, 1.70083661856991686e+00, 1.68639684677916812e+00,
+   1.67206075409760091e+00, 1.65782192095402414e+00, 1.64367415686286855e+00,
+   1.62961147947063467e+00, 1.61562809504316096e+00, 1.60171838022137814e+00,
+   1.58787686489057611e+00, 1.57409821602300082e+00, 1.56037722236616894e+00,
+   1.54670877985991040e+00, 1.53308787767404331e+00, 1.51950958476594011e+00,
+   1.50596903686320327e+00, 1.49246142378135405e+00, 1.47898197698992417e+00,
+   1.46552595734271085e+00, 1.45208864288922457e+00, 1.43866531668456354e+00,
+   1.42525125451406010e+00, 1.41184171244705770e+00, 1.39843191413100532e+00,
+   1.38501703773265183e+00, 1.37159220242734259e+00, 1.35815245433014353e+00,
+   1.34469275175354697e+00, 1.33120794966562728e+00, 1.31769278320941408e+00,
+   1.30414185012861683e+00, 1.29054959192619645e+00, 1.27691027356015563e+00,
+   1.26321796145462106e+00, 1.24946649957306821e+00, 1.23564948326336266e+00,
+   1.22176023053999638e+00, 1.20779175041594966e+00, 1.19373670783312869e+00,
+   1.17958738466398816e+00, 1.16533563616475244e+00, 1.15097284214886741e+00,
+   1.13648985201316077e+00, 1.12187692258254224e+00, 1.10712364753403603e+00,
+   1.09221887690727737e+00, 1.07715062489289570e+00, 1.06190596369482426e+00,
+   1.04647090076404536e+00, 1.03083023606819557e+00, 1.01496739525133051e+00,
+   9.98864233492983589e-01, 9.82500803515429011e-01, 9.65855079401149896e-01,
+   9.48902625511306441e-01, 9.31616196615150827e-01, 9.13965251023032277e-01,
+   8.95915352580937685e-01, 8.77427429112923374e-01, 8.58456843193813213e-01,
+   8.38952214297577381e-01, 8.18853906700357292e-01, 7.98092060644056911e-01,
+   7.76583987894759908e-01, 7.54230664454055622e-01, 7.30911910642488838e-01,
+   7.06479611335436464e-01, 6.80747918669154628e-01, 6.53478638739975248e-01,
+   6.24358597336050702e-01, 5.92962942471448318e-01, 5.58692178408185192e-01,
+   5.20656038762060569e-01, 4.77437837296689815e-01, 4.26547986355423514e-01,
+   3.62871431097031960e-01, 2.72320864813964669e-01, 0.00000000000000000e+00
+};
+const double ziggurat_nf[129] = {
+   1.01435256412037741e-03, 2.66962908388092279e-03, 5.54899522077134492e-03,
+   8.62448441285988514e-03, 1.18394786578848617e-02, 1.51672980105465680e-02,
+   1.85921027370112880e-02, 2.21033046159270982e-02, 2.56932919359342711e-02,
+   2.93563174400068502e-02, 3.30878861462257506e-02, 3.68843887866562026e-02,
+   4.07428680744441746e-02, 4.46608622004914246e-02, 4.86362958598678050e-02,
+   5.26674019030510115e-02, 5.67526634810498476e-02, 6.08907703480404058e-02,
+   6.50805852130680734e-02, 6.93211173935779079e-02, 7.36115018841134033e-02,
+   7.79509825139733936e-02, 8.23388982422356558e-02, 8.67746718947801782e-02,
+   9.12578008268302571e-02, 9.57878491217314387e-02, 1.00364441028655868e-01,
+   1.04987255409421318e-01, 1.09656021014840274e-01, 1.14370512448866007e-01,
+   1.19130546707650831e-01, 1.23935980202867821e-01, 1.28786706195943207e-01,
+   1.33682652583439365e-01, 1.38623779984594603e-01, 1.43610080090627756e-01,
+   1.48641574242342256e-01, 1.53718312208181662e-01, 1.58840371139479297e-01,
+   1.64007854683420384e-01, 1.69220892237365000e-01, 1.74479638330789499e-01,
+   1.79784272123295452e-01, 1.85134997008992191e-01, 1.90532040319137147e-01,
+   1.95975653116277737e-01, 2.01466110074313670e-01, 2.07003709439926520e-01,
+   2.12588773071730297e-01, 2.18221646554305398e-01, 2.23902699385008425e-01,
+   2.29632325232116130e-01, 2.35410942263479084e-01, 2.41238993545439817e-01,
+   2.47116947512321411e-01, 2.53045298507325767e-01, 2.59024567396204830e-01,
+   2.65055302255589209e-01, 2.71138079138384613e-01, 2.77273502919188120e-01,
+   2.83462208223232981e-01, 2.89704860442959844e-01, 2.96002156846932984e-01,
+   3.02354827786483538e-01, 3.08763638006181118e-01, 3.15229388065010885e-01,
+   3.21752915875984924e-01, 3.28335098372850298e-01, 3.34976853313589173e-01,
+   3.41679141231550410e-01, 3.48442967546326587e-01, 3.55269384847917091e-01,
+   3.62159495369317574e-01, 3.69114453664472209e-01, 3.76135469510562592e-01,
+   3.83223811055901198e-01, 3.90380808237314580e-01, 3.97607856493873313e-01,
+   4.04906420807222944e-01, 4.12278040102661003e-01, 4.19724332049574378e-01,
+   4.27246998304996073e-01, 4.34847830249990908e-01, 4.42528715275468443e-01,
+   4.50291643682039222e-01, 4.58138716267872059e-01, 4.66072152689456121e-01,
+   4.74094300693016946e-01, 4.82207646329485207e-01, 4.90414825283844114e-01,
+   4.98718635470979499e-01, 5.07122051075568958e-01, 5.15628238244001835e-01,
+   5.24240572672984073e-01, 5.32962659383836135e-01, 5.41798355025425504e-01,
+   5.50751793114604538e-01, 5.59827412704086869e-01, 5.69029991067950935e-01,
+   5.78364681119763135e-01, 5.87837054434706574e-01, 5.97453150944516675e-01,
+   6.07219536625120293e-01, 6.17143370818880932e-01, 6.27232485249927252e-01,
+   6.37495477335042304e-01, 6.47941821110222471e-01, 6.58582000050088046e-01,
+   6.69427667348890365e-01, 6.80491840997334063e-01, 6.91789143436675080e-01,
+   7.03336099016158123e-01, 7.15151507410498599e-01, 7.27256918344184822e-01,
+   7.39677243672647311e-01, 7.52441559174611418e-01, 7.65584173897704501e-01,
+   7.79146085929687704e-01, 7.93177011771305063e-01, 8.07738294682960545e-01,
+   8.22907211381408987e-01, 8.38783605295989609e-01, 8.55500607869450591e-01,
+   8.73243048910069541e-01, 8.92281650784026104e-01, 9.13043647971740202e-01,
+   9.36282681685059570e-01, 9.63599693127086154e-01, 1.00000000000000000e+00
+};
+
+/* x_i of the 256 layers of the exponential */
+const double ziggurat_ex[257] = {
+   8.69711747013108472e+00, 7.69711747013105008e+00, 6.94103362937721080e+00,
+   6.47837849383256703e+00, 6.14416466577247000e+00, 5.88214431579539632e+00,
+   5.66641016745403014e+00, 5.48289062752605894e+00, 5.32309050575439446e+00,
+   5.18148728130149649e+00, 5.05428848998130054e+00, 4.93877708590124698e+00,
+   4.83293974102510759e+00, 4.73524299660173664e+00, 4.64449188542008073e+00,
+   4.55973706170734694e+00, 4.48021174652841747e+00, 4.40528769347356786e+00,
+   4.33444368031726768e+00, 4.26724248027736142e+00, 4.20331371373517992e+00,
+   4.14234086566404702e+00, 4.08405131040829339e+00, 4.02820854464793232e+00,
+   3.97460606667378435e+00, 3.92306250013548530e+00, 3.87341767039950469e+00,
+   3.82552941852233230e+00, 3.77927099241166342e+00, 3.73452889403979293e+00,
+   3.69120109023741438e+00, 3.64919551576084933e+00, 3.60842881312890507e+00,
+   3.56882526564833302e+00, 3.53031588912933936e+00, 3.49283765477405561e+00,
+   3.45633282113275619e+00, 3.42074835725111592e+00, 3.38603544246029697e+00,
+   3.35214903090010541e+00, 3.31904747097074404e+00, 3.28669217159906468e+00,
+   3.25504730857044589e+00, 3.22407956528626016e+00, 3.19375790321223629e+00,
+   3.16405335802596888e+00, 3.13493885808443595e+00, 3.10638906233982004e+00,
+   3.07838021525408578e+00, 3.05089001661545067e+00, 3.02389750445567218e+00,
+   2.99738294951612616e+00, 2.97132775992108522e+00, 2.94571439489504128e+00,
+   2.92052628651273638e+00, 2.89574776860013738e+00, 2.87136401201553193e+00,
+   2.84736096563518437e+00, 2.82372530245003084e+00, 2.80044437025073334e+00,
+   2.77750614643975213e+00, 2.75489919656234017e+00, 2.73261263619469563e+00,
+   2.71063609586792431e+00, 2.68895968874179880e+00, 2.66757398077326169e+00,
+   2.64646996315180383e+00, 2.62563902679778316e+00, 2.60507293874083024e+00,
+   2.58476382021413542e+00, 2.56470412631689992e+00, 2.54488662711186464e+00,
+   2.52530439003782226e+00, 2.50595076352858825e+00, 2.48681936174020413e+00,
+   2.46790405029735949e+00, 2.44919893297824443e+00, 2.43069833926441436e+00,
+   2.41239681268886530e+00, 2.39428909992145256e+00, 2.37637014053613527e+00,
+   2.35863505740933199e+00, 2.34107914770302905e+00, 2.32369787439019060e+00,
+   2.30648685828357403e+00, 2.28944187053226367e+00, 2.27255882555314903e+00,
+   2.25583377436721344e+00, 2.23926289831290326e+00, 2.22284250311103104e+00,
+   2.20656901325765809e+00, 2.19043896672321425e+00, 2.17444900993776891e+00,
+   2.15859589304388022e+00, 2.14287646539983623e+00, 2.12728767131736252e+00,
+   2.11182654601903641e+00, 2.09649021180170925e+00, 2.08127587439321937e+00,
+   2.06618081949057020e+00, 2.05120240946857946e+00, 2.03633808024876428e+00,
+   2.02158533831892084e+00, 2.00694175789451279e+00, 1.99240497821357110e+00,
+   1.97797270095735467e+00, 1.96364268778954232e+00, 1.94941275800717895e+00,
+   1.93528078629704536e+00, 1.92124470059152186e+00, 1.90730248001838132e+00,
+   1.89345215293930180e+00, 1.87969179507220496e+00, 1.86601952769282153e+00,
+   1.85243351591116934e+00, 1.83893196701887351e+00, 1.82551312890351336e+00,
+   1.81217528852638421e+00, 1.79891677046028442e+00, 1.78573593548411935e+00,
+   1.77263117923129876e+00, 1.75960093088906810e+00, 1.74664365194606774e+00,
+   1.73375783498556491e+00, 1.72094200252192886e+00, 1.70819470587805133e+00,
+   1.69551452410153147e+00, 1.68290006291754746e+00, 1.67034995371644568e+00,
+   1.65786285257416632e+00, 1.64543743930371722e+00, 1.63307241653598489e+00,
+   1.62076650882825146e+00, 1.60851846179885194e+00, 1.59632704128647696e+00,
+   1.58419103253268245e+00, 1.57210923938622327e+00, 1.56008048352788165e+00,
+   1.54810360371450684e+00, 1.53617745504102543e+00, 1.52430090821921960e+00,
+   1.51247284887211042e+00, 1.50069217684281031e+00, 1.48895780551673940e+00,
+   1.47726866115612721e+00, 1.46562368224573869e+00, 1.45402181884878701e+00,
+   1.44246203197200606e+00, 1.43094329293887323e+00, 1.41946458276997656e+00,
+   1.40802489156952904e+00, 1.39662321791703548e+00, 1.38525856826311555e+00,
+   1.37392995632848391e+00, 1.36263640250508011e+00, 1.35137693325832875e+00,
+   1.34015058052949843e+00, 1.32895638113711012e+00, 1.31779337617631831e+00,
+   1.30666061041516768e+00, 1.29555713168659437e+00, 1.28448199027500598e+00,
+   1.27343423829623448e+00, 1.26241292906960867e+00, 1.25141711648084586e+00,
+   1.24044585433439969e+00, 1.22949819569384244e+00, 1.21857319220878346e+00,
+   1.20766989342675424e+00, 1.19678734608839599e+00, 1.18592459340419509e+00,
+   1.17508067431090435e+00, 1.16425462270567159e+00, 1.15344546665576742e+00,
+   1.14265222758166551e+00, 1.13187391941107141e+00, 1.12110954770132332e+00,
+   1.11035810872740393e+00, 1.09961858853259020e+00, 1.08888996193853971e+00,
+   1.07817119151136520e+00, 1.06746122647996056e+00, 1.05675900160254432e+00,
+   1.04606343597703688e+00, 1.03537343179052121e+00, 1.02468787300261011e+00,
+   1.01400562395708937e+00, 1.00332552791568941e+00, 9.92646405507268459e-01,
+   9.81967053085055164e-01, 9.71286240983895932e-01, 9.60602711668659071e-01,
+   9.49915177764068530e-01, 9.39222319955254847e-01, 9.28522784747202956e-01,
+   9.17815182070036761e-01, 9.07098082715682708e-01, 8.96370015589882385e-01,
+   8.85629464761743868e-01, 8.74874866291017406e-01, 8.64104604810996713e-01,
+   8.53317009842365470e-01, 8.42510351810360603e-01, 8.31682837734265101e-01,
+   8.20832606554403821e-01, 8.09957724057410178e-01, 7.99056177355478958e-01,
+   7.88125868869484325e-01, 7.77164609759121383e-01, 7.66170112735426234e-01,
+   7.55139984181973589e-01, 7.44071715500499442e-01, 7.32962673584356628e-01,
+   7.21810090308747321e-01, 7.10611050909646047e-01, 6.99362481103222966e-01,
+   6.88061132773738815e-01, 6.76703568029513480e-01, 6.65286141392668617e-01,
+   6.53804979847655510e-01, 6.42255960424526928e-01, 6.30634684933480627e-01,
+   6.18936451394866416e-01, 6.07156221620290260e-01, 5.95288584291493006e-01,
+   5.83327712748759608e-01, 5.71267316532578118e-01, 5.59100585511530190e-01,
+   5.46820125163299808e-01, 5.34417881237154724e-01, 5.21885051592124061e-01,
+   5.09211982443643185e-01, 4.96388045518659671e-01, 4.83401491653450144e-01,
+   4.70239275082157127e-01, 4.56886840931408134e-01, 4.43327866073540133e-01,
+   4.29543940225398269e-01, 4.15514169600343597e-01, 4.01214678896264665e-01,
+   3.86617977941106195e-01, 3.71692145329903523e-01, 3.56399760258379716e-01,
+   3.40696481064834633e-01, 3.24529117016894408e-01, 3.07832954674916615e-01,
+   2.90527955491214240e-01, 2.72513185478447773e-01, 2.53658363385894148e-01,
+   2.33790483059655663e-01, 2.12671510630946164e-01, 1.89958689622409693e-01,
+   1.65127622564162801e-01, 1.37304980939984694e-01, 1.04838507565785111e-01,
+   6.38521638149562448e-02, 0.00000000000000000e+00
+};
+const double ziggurat_ef[257] = {
+   1.67066692307958034e-04, 4.54134353841496603e-04, 9.67269282327176054e-04,
+   1.53629978030157669e-03, 2.14596774371891277e-03, 2.78879879357408567e-03,
+   3.46026477783691663e-03, 4.15729512083381179e-03, 4.87765598354241315e-03,
+   5.61964220720550904e-03, 6.38190593731920598e-03, 7.16335318363501682e-03,
+   7.96307743801707817e-03, 8.78031498580901515e-03, 9.61441364250225500e-03,
+   1.04648101810300275e-02, 1.13310135978346507e-02, 1.22125924262554437e-02,
+   1.31091649312550605e-02, 1.40203914031820035e-02, 1.49459680116912144e-02,
+   1.58856218399732289e-02, 1.68391068260400137e-02, 1.78062004109114345e-02,
+   1.87867007446961068e-02, 1.97804243380098263e-02, 2.07872040725782074e-02,
+   2.18068875042836778e-02, 2.28393354063853408e-02, 2.38844205115582818e-02,
+   2.49420264197318976e-02, 2.60120466451343353e-02, 2.70943837809559211e-02,
+   2.81889487639787571e-02, 2.92956602246375250e-02, 3.04144439104667430e-02,
+   3.15452321728937474e-02, 3.26879635089596873e-02, 3.38425821508744895e-02,
+   3.50090376973975700e-02, 3.61872847819315890e-02, 3.73772827729595275e-02,
+   3.85789955030750240e-02, 3.97923910233742989e-02, 4.10174413804150068e-02,
+   4.22541224133164278e-02, 4.35024135688883914e-02, 4.47622977329434901e-02,
+   4.60337610761753849e-02, 4.73167929131817766e-02, 4.86113855733797187e-02,
+   4.99175342827066007e-02, 5.12352370551265035e-02, 5.25644945930719212e-02,
+   5.39053101960463160e-02, 5.52576896766972733e-02, 5.66216412837431196e-02,
+   5.79971756312009160e-02, 5.93843056334205435e-02, 6.07830464454799310e-02,
+   6.21934154085413138e-02, 6.36154319998076673e-02, 6.50491177867540821e-02,
+   6.64944963853401211e-02, 6.79515934219369760e-02, 6.94204364987291295e-02,
+   7.09010551623722174e-02, 7.23934808757091403e-02, 7.38977469923651348e-02,
+   7.54138887340588121e-02, 7.69419431704809337e-02, 7.84819492016068515e-02,
+   8.00339475423203633e-02, 8.15979807092378912e-02, 8.31740930096328407e-02,
+   8.47623305323685905e-02, 8.63627411407573847e-02, 8.79753744672707033e-02,
+   8.96002819100333581e-02, 9.12375166310406827e-02, 9.28871335560440686e-02,
+   9.45491893760563723e-02, 9.62237425504333388e-02, 9.79108533114927682e-02,
+   9.96105836706377146e-02, 1.01322997425954214e-01, 1.03048160171258299e-01,
+   1.04786139306570755e-01, 1.06537004050002243e-01, 1.08300825451034380e-01,
+   1.10077676405185995e-01, 1.11867631670056936e-01, 1.13670767882744939e-01,
+   1.15487163578634172e-01, 1.17316899211556205e-01, 1.19160057175328335e-01,
+   1.21016721826675486e-01, 1.22886979509545816e-01, 1.24770918580831655e-01,
+   1.26668629437511338e-01, 1.28580204545228866e-01, 1.30505738468331467e-01,
+   1.32445327901388216e-01, 1.34399071702214379e-01, 1.36367070926429607e-01,
+   1.38349428863580981e-01, 1.40346251074863232e-01, 1.42357645432473007e-01,
+   1.44383722160635608e-01, 1.46424593878345777e-01, 1.48480375643867651e-01,
+   1.50551185001040783e-01, 1.52637142027443773e-01, 1.54738369384468999e-01,
+   1.56854992369366147e-01, 1.58987138969315128e-01, 1.61134939917592979e-01,
+   1.63298528751902788e-01, 1.65478041874937004e-01, 1.67673618617251219e-01,
+   1.69885401302528716e-01, 1.72113535315321114e-01, 1.74358169171354577e-01,
+   1.76619454590495994e-01, 1.78897546572479416e-01, 1.81192603475497427e-01,
+   1.83504787097768601e-01, 1.85834262762198277e-01, 1.88181199404255484e-01,
+   1.90545769663196585e-01, 1.92928149976772545e-01, 1.95328520679564466e-01,
+   1.97747066105100094e-01, 2.00183974691912514e-01, 2.02639439093710266e-01,
+   2.05113656293838986e-01, 2.07606827724223342e-01, 2.10119159388989590e-01,
+   2.12650861992979640e-01, 2.15202151075380071e-01, 2.17773247148701915e-01,
+   2.20364375843360882e-01, 2.22975768058121554e-01, 2.25607660116685454e-01,
+   2.28260293930718144e-01, 2.30933917169628883e-01, 2.33628783437434789e-01,
+   2.36345152457061086e-01, 2.39083290262450648e-01, 2.41843469398878741e-01,
+   2.44625969131893661e-01, 2.47431075665329181e-01, 2.50259082368863850e-01,
+   2.53110290015631068e-01, 2.55985007030416989e-01, 2.58883549749017838e-01,
+   2.61806242689364588e-01, 2.64753418835063870e-01, 2.67725419932046516e-01,
+   2.70722596799061743e-01, 2.73745309652804747e-01, 2.76793928448519189e-01,
+   2.79868833236974757e-01, 2.82970414538782633e-01, 2.86099073737078768e-01,
+   2.89255223489679691e-01, 2.92439288161894573e-01, 2.95651704281263250e-01,
+   2.98892921015583901e-01, 3.02163400675695692e-01, 3.05463619244592477e-01,
+   3.08794066934562461e-01, 3.12155248774181882e-01, 3.15547685227131280e-01,
+   3.18971912844959571e-01, 3.22428484956091499e-01, 3.25917972393558575e-01,
+   3.29440964264138825e-01, 3.32998068761811428e-01, 3.36589914028680104e-01,
+   3.40217149066782576e-01, 3.43880444704505017e-01, 3.47580494621639591e-01,
+   3.51318016437486058e-01, 3.55093752866790180e-01, 3.58908472948752499e-01,
+   3.62762973354820606e-01, 3.66658079781517043e-01, 3.70594648435148943e-01,
+   3.74573567615905156e-01, 3.78595759409583843e-01, 3.82662181496012888e-01,
+   3.86773829084140819e-01, 3.90931736984800271e-01, 3.95136981833293377e-01,
+   3.99390684475234348e-01, 4.03694012530533608e-01, 4.08048183152035782e-01,
+   4.12454465997164621e-01, 4.16914186433006428e-01, 4.21428728997620183e-01,
+   4.25999541143038007e-01, 4.30628137288462554e-01, 4.35316103215640404e-01,
+   4.40065100842357726e-01, 4.44876873414552454e-01, 4.49753251162758994e-01,
+   4.54696157474619556e-01, 4.59707615642141854e-01, 4.64789756250430452e-01,
+   4.69944825283964362e-01, 4.75175193037381816e-01, 4.80483363930458762e-01,
+   4.85871987341889577e-01, 4.91343869594037308e-01, 4.96901987241554377e-01,
+   5.02549501841352608e-01, 5.08289776410647876e-01, 5.14126393814753668e-01,
+   5.20063177368238816e-01, 5.26104213983625058e-01, 5.32253880263048762e-01,
+   5.38516872002867464e-01, 5.44898237672445385e-01, 5.51403416540647173e-01,
+   5.58038282262593444e-01, 5.64809192912406388e-01, 5.71723048664832145e-01,
+   5.78787358602851576e-01, 5.86010318477274694e-01, 5.93400901691740312e-01,
+   6.00968966365239332e-01, 6.08725382079629340e-01, 6.16682180915215095e-01,
+   6.24852738703673638e-01, 6.33251994214374059e-01, 6.41896716427274305e-01,
+   6.50805833414579538e-01, 6.60000841079008582e-01, 6.69506316731933948e-01,
+   6.79350572264774910e-01, 6.89566496117087868e-01, 7.00192655082798487e-01,
+   7.11274760805086781e-01, 7.22867659593583345e-01, 7.35038092431435475e-01,
+   7.47868621985207760e-01, 7.61463388849909717e-01, 7.75956852040130096e-01,
+   7.91527636972511384e-01, 8.08421651523025586e-01, 8.26993296643069420e-01,
+   8.47785500624011257e-01, 8.71704332381229019e-01, 9.00469929925778012e-01,
+   9.38143680862218998e-01, 1.00000000000000000e+00
+};
+
+/* U in [0, 1) from the 52 high bits of u, by the exponent of 1.0 (the
+   low bits are the layer and the sign) */
+static inline double ziggurat_unit(uint64_t u){
+   union { uint64_t u; double d; } t;
+   t.u = (u >> 12) | UINT64_C(0x3ff0000000000000);
+   return t.d - 1.0;
+}
+
+/* Uniform in (0, 1), never 0 for the log */
+double ziggurat_open(ismael_mt64_state *state){
+   return ((double)(int64_t)(mt19937_64_genrand(state) >> 11) + 0.5) * 0x1.0p-53;
+}
+
+/* Complete a normal number whose 64 bit number u is not in the fast
+   test */
+double ziggurat_normal_slow(ismael_mt64_state *state, uint64_t u){
+   int i;
+   double s, x, y;
+
+   for(;;){
+      i = (int)(u & 127);
+      s = (u & 128) ? -1.0 : 1.0;
+      x = ziggurat_unit(u) * ziggurat_nx[i];
+      if(x < ziggurat_nx[i+1]) return s * x;
+      if(i == 0){
+         /* Tail x > r */
+         do{
+            x = -log(ziggurat_open(state)) / ZIGGURAT_NR;
+            y = -log(ziggurat_open(state));
+         }while(y + y < x * x);
+         return s * (ZIGGURAT_NR + x);
+      }
+      /* Wedge */
+      y = ziggurat_nf[i] + ziggurat_open(state) *
+      (ziggurat_nf[i+1] - ziggurat_nf[i]);
+      if(y < exp(-0.5 * x * x)) return s * x;
+      u = mt19937_64_genrand(state);
+   }
+}
+
+double ziggurat_exponential_slow(ismael_mt64_state *state, uint64_t u){
+   int i;
+   double x, y, tail = 0.0;
+
+   for(;;){
+      i = (int)(u & 255);
+      x = ziggurat_unit(u) * ziggurat_ex[i];
+      if(x < ziggurat_ex[i+1]) return tail + x;
+      if(i == 0){
+         /* The tail x > r is r + exponential */
+         tail += ZIGGURAT_ER;
+      }else{
+         y = ziggurat_ef[i] + ziggurat_open(state) *
+         (ziggurat_ef[i+1] - ziggurat_ef[i]);
+         if(y < exp(-x)) return tail + x;
+      }
+      u = mt19937_64_genrand(state);
+   }
+}
+
+/* Normal number of mean 0 and variance 1 */
+double ziggurat_normal(ismael_mt64_state *state){
+   uint64_t u = mt19937_64_genrand(state);
+   const int i = (int)(u & 127);
+   const double x = ziggurat_unit(u) * ziggurat_nx[i];
+
+   if(x < ziggurat_nx[i+1]) return (u & 128) ? -x : x;
+   return ziggurat_normal_slow(state, u);
+}
+
+/* Exponential number of mean 1 */
+double ziggurat_exponential(ismael_mt64_state *state){
+   uint64_t u = mt19937_64_genrand(state);
+   const int i = (int)(u & 255);
+   const double x = ziggurat_unit(u) * ziggurat_ex[i];
+
+   if(x < ziggurat_ex[i+1]) return x;
+   return ziggurat_exponential_slow(state, u);
+}
+
+void ziggurat_normal_fill(ismael_mt64_state *state, double *x, size_t n){
+   size_t j, m;
+   int i;
+   uint64_t u[ZIGGURAT_BLOCK];
+   double c;
+   bool ok[ZIGGURAT_BLOCK];
+
+   while(n > 0){
+      m = (n < ZIGGURAT_BLOCK) ? n : ZIGGURAT_BLOCK;
+      mt19937_64_bits(state, u, m);
+      for(j = 0; j < m; ++j){
+         i = (int)(u[j] & 127);
+         c = ziggurat_unit(u[j]) * ziggurat_nx[i];
+         ok[j] = (c < ziggurat_nx[i+1]);
+         x[j] = (u[j] & 128) ? -c : c;
+      }
+      for(j = 0; j < m; ++j)
+         if(!ok[j]) x[j] = ziggurat_normal_slow(state, u[j]);
+      x += m;
+      n -= m;
+   }
+}
+
+void ziggurat_exponential_fill(ismael_mt64_state *state, double *x,
+size_t n){
+   size_t j, m;
+   int i;
+   uint64_t u[ZIGGURAT_BLOCK];
+   bool ok[ZIGGURAT_BLOCK];
+
+   while(n > 0){
+      m = (n < ZIGGURAT_BLOCK) ? n : ZIGGURAT_BLOCK;
+      mt19937_64_bits(state, u, m);
+      for(j = 0; j < m; ++j){
+         i = (int)(u[j] & 255);
+         x[j] = ziggurat_unit(u[j]) * ziggurat_ex[i];
+         ok[j] = (x[j] < ziggurat_ex[i+1]);
+      }
+      for(j = 0; j < m; ++j)
+         if(!ok[j]) x[j] = ziggurat_exponential_slow(state, u[j]);
+      x += m;
+      n -= m;
+   }
+}
+
+#undef ZIGGURAT_NR
+#undef ZIGGURAT_ER
+#undef ZIGGURAT_BLOCK
@@ -0,0 +1,110 @@
+/*
+cc test_chain.c -lm -o test_chain && time ./test_chain
+*/
+#include "libismael/ismael.h"
+
+int main(void){
+   int N, m, k;
+   double *V, *w, *v, *e, residual, orthogonality, x;
+
+   /* Anderson chain with the site energies of random.distance and
+      hopping 1 */
+   N = 10000;
+   V = ismael.random.distance(1.0, N, 2);
+
+   /* The 20 eigenvalues around the center of the band */
+   m = 20;
+   w = ialloc(m, double);
+   v = ialloc(m * N, double);
+   e = NULL;
+   x = 0.5;
+   k = ismael.tridiag.count(V, e, N, x);
+   ismael.tridiag.eigenvalues(V, e, N, k - m/2, k + m/2 - 1, w);
+   ismael.tridiag.eigenvectors(V, e, N, w, m, v);
+
+   /* |T v - w v| and |v_j . v_k - delta_jk| */
+   residual = orthogonality = 0.0;
+   for(int j = 0; j < m; ++j){
+      double *vj = v + j * N, r;
+      for(int i = 0; i < N; ++i){
+         r = (V[i] - w[j]) * vj[i];
+         if(i > 0) r += vj[i-1];
+         if(i < N - 1) r += vj[i+1];
+         residual = fmax(residual, fabs(r));
+      }
+      for(int k = 0; k <= j; ++k){
+         double s = 0.0;
+         for(int i = 0; i < N; ++i) s += vj[i] * v[k * N + i];
+         orthogonality = fmax(orthogonality, fabs(s - (j == k)));
+      }
+   }
+   printf("tridiag: N = %d, eigenvalues from %g to %g, residual = %g, "
+   "orthogonality = %g\n", N, w[0], w[m-1], residual, orthogonality);
+   for(int j = 0; j < m; j += 5)
+      printf("   E = %g, participation = %g\n", w[j],
+      ismael.tridiag.participation(v + j * N, N));
+
+   free(w);
+   free(v);
+   free(V);
+
+   /* Lyapunov exponent of 10^8 sites with uniform disorder in
+      [-W/2, W/2], generated in chunks of 10^5, against the perturbation
+      theory gamma = W^2 / (96 (1 - E^2/4)) [Thouless] */
+   {
+      int m = 5;
+      size_t chunk = 100000;
+      double E[5] = {-1.5, -1.0, 0.5, 1.0, 1.5}, gamma[5], W = 1.0;
+      ismael_transfer T;
+
+      w = ialloc(chunk, double);
+      ismael.transfer.init(&T, E, m);
+      for(int c = 0; c < 1000; ++c){
+         ismael.random.philox_fill(7, c * chunk, w, chunk);
+         for(size_t i = 0; i < chunk; ++i) w[i] = W * (w[i] - 0.5);
+         ismael.transfer.add(&T, w, chunk);
+      }
+      ismael.transfer.lyapunov(&T, gamma);
+      for(int k = 0; k < m; ++k)
+         printf("transfer: E = %g, gamma = %g, perturbation theory = %g\n",
+         E[k], gamma[k], W * W / (96.0 * (1.0 - 0.25 * E[k] * E[k])));
+      ismael.transfer.free(&T);
+      free(w);
+   }
+
+   /* Density of states of the clean chain of 10^5 sites, against
+      1 / (pi sqrt(4 - E^2)), and of a 256x256 lattice with the disorder
+      of random.fourier */
+   {
+      int L[2] = {100000, 256};
+      double **dos, error = 0.0, exact;
+      ismael_sparse H;
+
+      ismael.kpm.lattice(&H, 1, L, NULL, true);
+      dos = ismael.kpm.dos(&H, 512, 8, 1000, 3);
+      for(int i = 0; i < 1000; ++i){
+         if(fabs(dos[0][i]) > 1.5) continue;
+         exact = 1.0 / (M_PI * sqrt(4.0 - dos[0][i] * dos[0][i]));
+         error = fmax(error, fabs(dos[1][i] - exact) / exact);
+      }
+      printf("kpm chain: maximum relative error for |E| < 1.5 = %g\n", error);
+      ismael.kpm.free(&H);
+      free(dos[0]); free(dos[1]); free(dos);
+
+      L[0] = 256;
+      V = ismael.random.fourier(1.0, L[0] * L[1], 2);
+      ismael.kpm.lattice(&H, 2, L, V, true);
+      dos = ismael.kpm.dos(&H, 256, 8, 400, 3);
+      error = 0.0;
+      for(int i = 1; i < 400; ++i)
+         error += 0.5 * (dos[1][i] + dos[1][i-1]) * (dos[0][i] - dos[0][i-1]);
+      printf("kpm lattice: E in [%g, %g], integral of the density = %g\n",
+      dos[0][0], dos[0][399], error);
+      ismael.kpm.free(&H);
+      free(dos[0]); free(dos[1]); free(dos);
+      free(V);
+   }
+   return 0;
+}
+
+#include "libismael/ismael.c"
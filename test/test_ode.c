@@ -0,0 +1,266 @@
+/*
+cc test_ode.c -lm -o test_ode && time ./test_ode
+*/
+#include "libismael/ismael.h"
+
+/* Harmonic oscillator, y'' = -y */
+void oscillator(double t, const double *y, double *dydt, void *params){
+   (void)t; (void)params;
+   dydt[0] = y[1];
+   dydt[1] = -y[0];
+}
+
+void oscillator_long(long double t, const long double *y, long double *dydt,
+void *params){
+   (void)t; (void)params;
+   dydt[0] = y[1];
+   dydt[1] = -y[0];
+}
+
+/* Event x = 0 of the oscillator */
+double crossing(double t, const double *y, void *params){
+   (void)t; (void)params;
+   return y[0];
+}
+
+/* Kepler problem, y = (x, y, vx, vy) */
+void kepler(double t, const double *y, double *dydt, void *params){
+   double r3;
+   (void)t; (void)params;
+   r3 = pow(y[0] * y[0] + y[1] * y[1], 1.5);
+   dydt[0] = y[2];
+   dydt[1] = y[3];
+   dydt[2] = -y[0] / r3;
+   dydt[3] = -y[1] / r3;
+}
+
+/* Ensemble of oscillators y'' = -w^2 y, w[m] for the member m */
+void oscillators(const double *t, const double *y, double *dydt, int K,
+void *params){
+   const double *w = params;
+   (void)t;
+   for(int m = 0; m < K; ++m){
+      dydt[m] = y[K + m];
+      dydt[K + m] = -w[m] * w[m] * y[m];
+   }
+}
+
+/* Seed of the generator of the problem i of ode.sweep, of src/ode_sweep.c */
+uint64_t ode_sweep_seed(uint64_t seed, int i);
+
+/* Problem i of the sweep: random initial condition, the even problems
+   change the tolerance and the problems 7, 17, ... fail by hmin */
+void sweep_setup(int i, double *y0, ismael_ode *ode, ismael_mt64_state *rng,
+void *params){
+   (void)params;
+   y0[0] = ismael.random.mt64_next(rng);
+   y0[1] = ismael.random.mt64_next(rng) - 0.5;
+   if(i % 2 == 0) ode->rtol = 1.0e-6;
+   if(i % 10 == 7){
+      ode->rtol = ode->atol = 1.0e-20;
+      ode->hmin = 0.1;
+   }
+}
+
+double kepler_energy(const double *y){
+   return 0.5 * (y[2] * y[2] + y[3] * y[3])
+   - 1.0 / sqrt(y[0] * y[0] + y[1] * y[1]);
+}
+
+int main(void){
+   ismael_ode ode;
+   ismael_ode_ensemble ens;
+   double y0[4], e, t1, w[16], yk[32], error;
+
+   /* Harmonic oscillator until t = 100 */
+   t1 = 100.0;
+   y0[0] = 1.0; y0[1] = 0.0;
+   ismael.ode.init(&ode, ISMAEL_RK8, 2, oscillator, NULL);
+   ismael.ode.set(&ode, 0.0, y0);
+   ismael.ode.evolve(&ode, t1);
+   printf("oscillator: t = %g, error = %g, steps = %ld, rejected = %ld, "
+   "f evaluations = %ld\n", ode.t, fabs(ode.y[0] - cos(t1)),
+   ode.nsteps, ode.nrejected, ode.nfev);
+   ismael.ode.free(&ode);
+
+   /* Dense output in 1000 points, compared with the error in the steps
+      and without evaluations of f more than the steps */
+   for(int i = 0; i < 2; ++i){
+      double step_error = 0.0;
+      long nfev;
+      ismael.ode.init(&ode, i ? ISMAEL_RK14 : ISMAEL_RK8, 2, oscillator, NULL);
+      ismael.ode.set(&ode, 0.0, y0);
+      while(ode.t < 100.0) ismael.ode.step(&ode);
+      nfev = ode.nfev;
+      ismael.ode.free(&ode);
+
+      ismael.ode.init(&ode, i ? ISMAEL_RK14 : ISMAEL_RK8, 2, oscillator, NULL);
+      ode.dense = true;
+      ismael.ode.set(&ode, 0.0, y0);
+      error = 0.0;
+      while(ode.t < 100.0){
+         double t0 = ode.t, y[2];
+         ismael.ode.step(&ode);
+         step_error = fmax(step_error, fabs(ode.y[0] - cos(ode.t)));
+         for(int j = (int)ceil(10.0 * t0); j <= (int)floor(10.0 * ode.t); ++j){
+            ismael.ode.interpolate(&ode, 0.1 * j, y);
+            error = fmax(error, fabs(y[0] - cos(0.1 * j)));
+         }
+      }
+      printf("dense output rk%d: maximum error = %g (%g in the steps), "
+      "f evaluations = %ld (%ld without dense output)\n", i ? 14 : 8,
+      error, step_error, ode.nfev, nfev);
+      ismael.ode.free(&ode);
+   }
+
+   /* The first 10 zeros of cos(t) */
+   ismael.ode.init(&ode, ISMAEL_RK8, 2, oscillator, NULL);
+   ismael.ode.set(&ode, 0.0, y0);
+   error = 0.0;
+   for(int j = 0; j < 10; ++j){
+      ismael.ode.evolve_event(&ode, 100.0, crossing);
+      error = fmax(error, fabs(ode.t - (j + 0.5) * M_PI));
+   }
+   printf("events: maximum error = %g\n", error);
+   ismael.ode.free(&ode);
+
+   /* 10^6 fixed steps of the oscillator in the three precisions */
+   t1 = 1000.0;
+   for(int i = 0; i < 3; ++i){
+      ismael.ode.init(&ode, ISMAEL_RK8, 2, oscillator, NULL);
+      ode.fl = oscillator_long;
+      ode.adaptive = false;
+      ode.h = 1.0e-3;
+      ismael.ode.set_precision(&ode, i);
+      ismael.ode.set(&ode, 0.0, y0);
+      ismael.ode.evolve(&ode, t1);
+      printf("oscillator %s: error = %g, steps = %ld\n",
+      (i == ISMAEL_ODE_DOUBLE) ? "double" :
+      (i == ISMAEL_ODE_COMPENSATED) ? "compensated" : "long double",
+      fabs(ode.y[0] - cos(t1)), ode.nsteps);
+      ismael.ode.free(&ode);
+   }
+
+   /* Kepler orbit with eccentricity 0.5 for 10 periods, with rk8 and rk14
+      at a tight tolerance */
+   e = 0.5;
+   t1 = 20.0 * M_PI;
+   y0[0] = 1.0 - e; y0[1] = 0.0;
+   y0[2] = 0.0; y0[3] = sqrt((1.0 + e) / (1.0 - e));
+   for(int i = 0; i < 2; ++i){
+      ismael.ode.init(&ode, i ? ISMAEL_RK14 : ISMAEL_RK8, 4, kepler, NULL);
+      ode.rtol = 1.0e-14;
+      ode.atol = 1.0e-16;
+      ismael.ode.set(&ode, 0.0, y0);
+      ismael.ode.evolve(&ode, t1);
+      printf("kepler rk%d: t = %g, position error = %g, energy error = %g, "
+      "steps = %ld, rejected = %ld, f evaluations = %ld\n",
+      i ? 14 : 8, ode.t,
+      hypot(ode.y[0] - y0[0], ode.y[1] - y0[1]),
+      fabs(kepler_energy(ode.y) - kepler_energy(y0)),
+      ode.nsteps, ode.nrejected, ode.nfev);
+      ismael.ode.free(&ode);
+   }
+
+   /* Wave packet in a disordered chain of 64 sites, i dpsi/dt = H psi,
+      with and without the projection to the norm */
+   {
+      int N = 64;
+      double eps[64], hop[64], *d[2] = {eps, hop}, norm, energy[2];
+      _Complex double psi[64], hpsi[64];
+      ismael_band_hamiltonian H = {64, 1, d, false};
+      ismael_mt64_state rng;
+
+      ismael.random.mt64_init(&rng, 5489);
+      for(int r = 0; r < N; ++r){
+         eps[r] = ismael.random.mt64_next(&rng) - 0.5;
+         hop[r] = -1.0;
+         psi[r] = exp(-0.05 * (r - 32) * (r - 32)) * cexp(I * 1.0 * r);
+      }
+      for(int i = 0; i < 2; ++i){
+         ismael.ode.init_complex(&ode, ISMAEL_RK8, N, ismael.ode.hamiltonian,
+         &H);
+         ode.conserve = i;
+         ode.rtol = 1.0e-6;
+         ode.atol = 1.0e-8;
+         ismael.ode.set_complex(&ode, 0.0, psi);
+         ismael.ode.evolve(&ode, 1000.0);
+         ismael.ode.get_complex(&ode, hpsi);
+         norm = 0.0;
+         for(int r = 0; r < N; ++r) norm += creal(hpsi[r] * conj(hpsi[r]));
+         /* Energy <psi|H|psi> / <psi|psi> in the end and in the start */
+         for(int j = 0; j < 2; ++j){
+            _Complex double *p = j ? psi : hpsi, e = 0.0;
+            for(int r = 0; r < N; ++r){
+               _Complex double hp = eps[r] * p[r];
+               if(r > 0) hp += hop[r-1] * p[r-1];
+               if(r < N - 1) hp += hop[r] * p[r+1];
+               e += conj(p[r]) * hp;
+            }
+            energy[j] = creal(e);
+         }
+         printf("schrodinger %s: norm error = %g, energy error = %g, "
+         "steps = %ld\n", i ? "projected" : "free",
+         fabs(norm - ode.norm) / ode.norm,
+         fabs(energy[0] / norm - energy[1] / ode.norm), ode.nsteps);
+         ismael.ode.free(&ode);
+      }
+   }
+
+   /* Ensemble of 16 oscillators with different frequencies */
+   t1 = 100.0;
+   for(int m = 0; m < 16; ++m){
+      w[m] = 1.0 + 0.1 * m;
+      yk[m] = 1.0;
+      yk[16 + m] = 0.0;
+   }
+   ismael.ode.ensemble_init(&ens, ISMAEL_RK8, 2, 16, oscillators, w);
+   ismael.ode.ensemble_set(&ens, 0.0, yk);
+   ismael.ode.ensemble_evolve(&ens, t1);
+   error = 0.0;
+   for(int m = 0; m < 16; ++m)
+      error = fmax(error, fabs(ens.y[m] - cos(w[m] * t1)));
+   printf("ensemble: maximum error = %g, steps = %ld, rejected = %ld, "
+   "f evaluations = %ld\n", error, ens.nsteps, ens.nrejected, ens.nfev);
+   ismael.ode.ensemble_free(&ens);
+
+   /* Sweep of 40 oscillators compared with the same problems one by one,
+      the result do not depend of the threads */
+   {
+      int N = 40, nt = 5, failed, nfailed = 0, equal = 1;
+      double times[5] = {1.0, 2.0, 3.0, 4.0, 5.0}, *out, y[2];
+      ismael_mt64_state rng;
+
+      out = malloc((size_t)N * nt * 2 * sizeof(double));
+      failed = ismael.ode.sweep(ISMAEL_RK8, 2, N, oscillator, sweep_setup,
+      NULL, 0.0, times, nt, out, 2);
+      for(int i = 0; i < N; ++i){
+         ismael.ode.init(&ode, ISMAEL_RK8, 2, oscillator, NULL);
+         ismael.random.mt64_init(&rng, ode_sweep_seed(2, i));
+         y[0] = y[1] = 0.0;
+         sweep_setup(i, y, &ode, &rng, NULL);
+         ismael.ode.set(&ode, 0.0, y);
+         for(int j = 0; j < nt; ++j){
+            const double *o = out + ((size_t)i * nt + j) * 2;
+            if(ismael.ode.evolve(&ode, times[j]) != 0){
+               ++nfailed;
+               for(; j < nt; ++j){
+                  o = out + ((size_t)i * nt + j) * 2;
+                  equal &= isnan(o[0]) && isnan(o[1]);
+               }
+               break;
+            }
+            equal &= (o[0] == ode.y[0]) && (o[1] == ode.y[1]);
+         }
+         ismael.ode.free(&ode);
+      }
+      printf("sweep: %d problems, %d failed (%d one by one), %s\n", N, failed,
+      nfailed, (equal && (failed == nfailed)) ? "equal to the serial loop" :
+      "DIFFERENT of the serial loop");
+      free(out);
+   }
+
+   return 0;
+}
+
+#include "libismael/ismael.c"
@@ -5,12 +5,16 @@ cc test_random.c -lm -o test_random && time ./test_random
 
 #if (__STDC_VERSION__ >= 201112L) /* ISO C11 */
    #define alloc(size, type) \
-   (type*)aligned_alloc(sizeof(type), (size_t)size * sizeof(type))
+   (type*)aligned_alloc(sizeof(type), (size_t)(size) * sizeof(type))
 #else
    #define alloc(size, type) \
-   (type*)malloc((size_t)size * sizeof(type))
+   (type*)malloc((size_t)(size) * sizeof(type))
 #endif /* ISO C11 */
 
+/* Rounds of Philox over one counter, of src/philox.c */
+void philox4x32(uint32_t *ctr, const uint32_t *key);
+double philox_todouble(uint32_t lo, uint32_t hi);
+
 int main(void){
    int Q;
    uint64_t seed;
@@ -18,6 +22,24 @@ int main(void){
    FILE *fil;
    partitions = 400;
 
+   /* The trajectories of random.bernoulli_batch are the ones of
+      random.bernoulli, this is the first use of the legacy mt64 then the
+      seed of bernoulli is used */
+   {
+      int N = 2000, M = 3, seeds[3] = {1, 3, 6};
+      double alpha[3] = {0.5, 1.0, 1.5}, *X, *Y;
+      X = alloc(N * M, double);
+      ismael.random.bernoulli_batch(X, alpha, seeds, M, N);
+      Y = ismael.random.bernoulli(alpha[0], N, seeds[0]);
+      correlation = 0.0;
+      for(int i = 0; i < N; ++i)
+         correlation = fmax(correlation, fabs(X[i*M] - Y[i]));
+      printf("bernoulli_batch: maximum difference to bernoulli = %g\n",
+      correlation);
+      free(X);
+      free(Y);
+   }
+
    /* Quantitie of random numbers to generate */
    Q = 1000000;
    rand = alloc(Q, double);
@@ -37,6 +59,171 @@ int main(void){
    fclose(fil);
    free(rand);
 
+   /* Known answer of dSFMT-19937: the first numbers in [1, 2) of the
+      reference implementation with init_gen_rand(0) */
+   {
+      const double ref[2] = {1.030581026769374, 1.213140320067012};
+      double error = 0.0;
+      ismael_dsfmt_state state;
+      ismael.random.dsfmt_init(&state, 0);
+      for(int i = 0; i < 2; ++i)
+         error = fmax(error, fabs(1.0 + ismael.random.dsfmt_next(&state)
+         - ref[i]));
+      printf("dsfmt: known answer test %s\n",
+      (error < 1.0e-15) ? "passed" : "FAILED");
+   }
+
+   /* Known answers of Philox4x32-10 (kat_vectors of Random123): counter,
+      key and the result */
+   {
+      const uint32_t kat[3][10] = {
+         {0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+          0x00000000, 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+         {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+          0xffffffff, 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+         {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822,
+          0x299f31d0, 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}
+      };
+      uint32_t ctr[4];
+      int passed = 1;
+      for(int k = 0; k < 3; ++k){
+         for(int i = 0; i < 4; ++i) ctr[i] = kat[k][i];
+         philox4x32(ctr, kat[k] + 4);
+         for(int i = 0; i < 4; ++i) passed &= (ctr[i] == kat[k][6+i]);
+      }
+      /* The first number of the stream 0 is the first counter */
+      passed &= (ismael.random.philox(0, 0) ==
+      philox_todouble(kat[0][6], kat[0][7]));
+      printf("philox: known answer test %s\n", passed ? "passed" : "FAILED");
+   }
+
+   /* Jumps of 2^k steps of mt64 and mt32 compared with 2^k draws, and the
+      streams of split with the sequential draws */
+   {
+      /* phi(x) is used only if 2^k is larger than its degree 19937 */
+      const int ks[6] = {0, 4, 5, 6, 15, 20};
+      int passed = 1, k, P = 4;
+      double a, b;
+      ismael_mt_jump jump;
+      ismael_mt64_state s64, r64, st64[4];
+      ismael_mt32_state s32, r32, st32[4];
+
+      for(int q = 0; q < 6; ++q){
+         k = ks[q];
+         ismael.random.mt64_init(&s64, seed);
+         ismael.random.mt32_init(&s32, (uint32_t)seed);
+         for(int i = 0; i < 7; ++i){ /* start in the middle of a block */
+            ismael.random.mt64_next(&s64);
+            ismael.random.mt32_next(&s32);
+         }
+         r64 = s64;
+         r32 = s32;
+         ismael.random.mt64_jump_init(&jump, k);
+         ismael.random.mt64_jump(&s64, &jump);
+         ismael.random.mt32_jump_init(&jump, k);
+         ismael.random.mt32_jump(&s32, &jump);
+         for(int i = 0; i < (1 << k); ++i){
+            ismael.random.mt64_next(&r64);
+            ismael.random.mt32_next(&r32);
+         }
+         for(int i = 0; i < 1000; ++i){
+            a = ismael.random.mt64_next(&s64);
+            b = ismael.random.mt64_next(&r64);
+            passed &= (a == b);
+            a = ismael.random.mt32_next(&s32);
+            b = ismael.random.mt32_next(&r32);
+            passed &= (a == b);
+         }
+      }
+
+      k = 10;
+      ismael.random.mt64_split(st64, P, seed, k);
+      ismael.random.mt32_split(st32, P, (uint32_t)seed, k);
+      ismael.random.mt64_init(&r64, seed);
+      ismael.random.mt32_init(&r32, (uint32_t)seed);
+      for(int i = 0; i < P; ++i){
+         for(int j = 0; j < (1 << k); ++j){
+            passed &= (ismael.random.mt64_next(&st64[i]) ==
+            ismael.random.mt64_next(&r64));
+            passed &= (ismael.random.mt32_next(&st32[i]) ==
+            ismael.random.mt32_next(&r32));
+         }
+      }
+      printf("mt jump and split: %s\n", passed ? "passed" : "FAILED");
+   }
+
+   /* Normal numbers by the Ziggurat method */
+   {
+      ismael_mt64_state state;
+      ismael.random.mt64_init(&state, seed);
+      rand = alloc(Q, double);
+      ismael.random.normal_fill(&state, rand, Q);
+      {
+         ismael_moments m;
+         ismael.moments.init(&m);
+         ismael.moments.add(&m, rand, Q);
+         printf("normal: mean = %g, variance = %g, skewness = %g, "
+         "kurtosis = %g, min = %g, max = %g\n", m.mean,
+         ismael.moments.variance(&m), ismael.moments.skewness(&m),
+         ismael.moments.kurtosis(&m), m.min, m.max);
+      }
+      pdf = ismael.FDP(rand, Q, partitions);
+      fil = fopen("random_normal.dat", "w");
+      for(int i = 0; i < partitions; ++i)
+      fprintf(fil, "%g %g\n", pdf[0][i], pdf[1][i]);
+      fclose(fil);
+
+      /* New numbers with the density of the histogram, the first bin of
+         FDP start in the minimum of the sample */
+      {
+         double lo = rand[0];
+         ismael_alias sampler;
+         for(int i = 1; i < Q; ++i) lo = fmin(lo, rand[i]);
+         ismael.alias.init(&sampler, pdf, partitions, lo);
+         ismael.alias.fill(&sampler, &state, rand, Q);
+         free(pdf[0]); free(pdf[1]); free(pdf);
+         pdf = ismael.FDP(rand, Q, partitions);
+         fil = fopen("random_alias.dat", "w");
+         for(int i = 0; i < partitions; ++i)
+         fprintf(fil, "%g %g\n", pdf[0][i], pdf[1][i]);
+         fclose(fil);
+         ismael.alias.free(&sampler);
+      }
+      free(rand);
+   }
+
+   /* Integral of prod_j (|4 x_j - 2| + j^2) / (1 + j^2) = 1 in 10
+      dimensions by Monte Carlo and quasi-Monte Carlo */
+   {
+      int d = 10, N = 1 << 16;
+      double x[10], sum[3], f;
+      ismael_mt64_state state;
+      ismael_sobol sobol;
+      ismael_halton halton;
+
+      ismael.random.mt64_init(&state, seed);
+      ismael.random.sobol_init(&sobol, d, &state);
+      ismael.random.halton_init(&halton, d, NULL);
+      for(int k = 0; k < 3; ++k) sum[k] = 0.0;
+      for(int i = 0; i < N; ++i){
+         for(int k = 0; k < 3; ++k){
+            if(k == 0) for(int j = 0; j < d; ++j)
+               x[j] = ismael.random.mt64_next(&state);
+            if(k == 1) ismael.random.sobol_next(&sobol, x);
+            if(k == 2) ismael.random.halton_next(&halton, x);
+            f = 1.0;
+            for(int j = 1; j <= d; ++j)
+               f *= (fabs(4.0 * x[j-1] - 2.0) + j * j) / (1.0 + j * j);
+            sum[k] += f / N;
+         }
+      }
+      printf("integral with %d points: error mt64 = %g, sobol = %g, "
+      "halton = %g\n", N, fabs(sum[0] - 1.0), fabs(sum[1] - 1.0),
+      fabs(sum[2] - 1.0));
+      ismael.random.sobol_free(&sobol);
+      ismael.random.halton_free(&halton);
+   }
+
    /* Now generate correlated random numbers and repeat the other process */
    correlation = 1.0;
    rand = ismael.random.distance(correlation, Q, seed);
@@ -56,6 +243,33 @@ int main(void){
    fclose(fil);
    free(rand);
 
+   /* Exponent of S(f) ~ f^-alpha of random.fourier, averaged over 20
+      sequences */
+   {
+      int N = 1 << 16, m = 0;
+      double **S, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0, X, Y;
+      ismael_spectrum spectrum;
+
+      ismael.spectrum.init(&spectrum, N, 4096);
+      for(int k = 1; k <= 20; ++k){
+         rand = ismael.random.fourier(2.0, N, k);
+         ismael.spectrum.add(&spectrum, rand);
+         free(rand);
+      }
+      S = ismael.spectrum.power(&spectrum);
+      for(int j = 1; j < spectrum.np; ++j){
+         if((S[0][j] < 2.0e-3) || (S[0][j] > 5.0e-2)) continue;
+         X = log(S[0][j]);
+         Y = log(S[1][j]);
+         sx += X; sy += Y; sxx += X * X; sxy += X * Y;
+         ++m;
+      }
+      printf("fourier: alpha = 2, exponent of the spectrum = %g\n",
+      -(m * sxy - sx * sy) / (m * sxx - sx * sx));
+      free(S[0]); free(S[1]); free(S);
+      ismael.spectrum.free(&spectrum);
+   }
+
    correlation = 1.0;
    rand = ismael.random.fourier(correlation, Q, seed);
    pdf = ismael.FDP(rand, Q, partitions);